@@ -0,0 +1,170 @@
+#ifndef PODIO_ASYNCWRITER_H
+#define PODIO_ASYNCWRITER_H
+
+#include "podio/Frame.h"
+#include "podio/Writer.h"
+#include "podio/WriterOptions.h"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace podio {
+
+/// Statistics about the Frames that have been written by an AsyncWriter
+struct AsyncWriterStatistics {
+  size_t nWritten{0};      ///< The number of Frames that have been written
+  size_t maxQueueDepth{0}; ///< The maximum number of Frames that were queued at the same time
+  size_t nWaits{0};        ///< The number of times writeFrame had to wait for space in the queue
+};
+
+/// The AsyncWriter writes Frames on a dedicated background I/O thread.
+///
+/// Frames that are moved into the AsyncWriter are put into a bounded queue,
+/// from which they are written by another writer on the I/O thread. Hence, the
+/// caller only has to wait if the queue is full. Frames that are passed by
+/// const reference cannot be queued, since the caller keeps ownership. For
+/// those the queue is drained first and the Frame is then written directly.
+///
+/// Exceptions that occur on the I/O thread are rethrown on the next call to
+/// writeFrame or finish. All Frames that were still queued at that point are
+/// discarded.
+///
+/// The AsyncWriter itself has to be used from only one thread. It can also be
+/// wrapped into a podio::Writer, see makeAsyncWriter
+class AsyncWriter {
+public:
+  /// The default maximum number of Frames that are queued for writing
+  static constexpr size_t defaultQueueSize = 8;
+
+  /// Create an AsyncWriter that uses the passed writer on the I/O thread
+  ///
+  /// @note This enables ROOT's thread safety (ROOT::EnableThreadSafety), since
+  /// files can be read or written on the calling thread while the I/O thread is
+  /// writing.
+  ///
+  /// @param writer    The writer that does the actual writing. This can also be
+  ///                  created from any of the low level writers
+  /// @param queueSize The maximum number of Frames that can be queued. If the
+  ///                  queue is full, writeFrame blocks until there is space again
+  AsyncWriter(podio::Writer writer, size_t queueSize = defaultQueueSize);
+
+  /// AsyncWriter destructor
+  ///
+  /// This writes all queued Frames and then takes care of writing all the
+  /// necessary metadata to read files back again. Errors from the I/O thread
+  /// can only be reported to std::cerr at this point.
+  ~AsyncWriter();
+
+  /// The AsyncWriter is not copy-able
+  AsyncWriter(const AsyncWriter&) = delete;
+  /// The AsyncWriter is not copy-able
+  AsyncWriter& operator=(const AsyncWriter&) = delete;
+  /// The AsyncWriter is not move-able, since the I/O thread refers to it
+  AsyncWriter(AsyncWriter&&) = delete;
+  /// The AsyncWriter is not move-able, since the I/O thread refers to it
+  AsyncWriter& operator=(AsyncWriter&&) = delete;
+
+  /// Queue the given Frame for writing all its collections under the given
+  /// category.
+  ///
+  /// @param frame    The Frame to store
+  /// @param category The category name under which this Frame should be stored
+  ///
+  /// @throws Any exception that occurred while writing a previous Frame
+  void writeFrame(podio::Frame&& frame, const std::string& category);
+
+  /// Queue the given Frame for writing the desired collections under the given
+  /// category.
+  ///
+  /// @param frame        The Frame to store
+  /// @param category     The category name under which this Frame should be
+  ///                     stored
+  /// @param collsToWrite The collection names that should be written
+  ///
+  /// @throws Any exception that occurred while writing a previous Frame
+  void writeFrame(podio::Frame&& frame, const std::string& category, const std::vector<std::string>& collsToWrite);
+
+  /// Write all collections of the given Frame under the given category, after
+  /// all queued Frames have been written.
+  ///
+  /// @param frame    The Frame to store
+  /// @param category The category name under which this Frame should be stored
+  void writeFrame(const podio::Frame& frame, const std::string& category);
+
+  /// Write the desired collections of the given Frame under the given category,
+  /// after all queued Frames have been written.
+  ///
+  /// @param frame        The Frame to store
+  /// @param category     The category name under which this Frame should be
+  ///                     stored
+  /// @param collsToWrite The collection names that should be written
+  void writeFrame(const podio::Frame& frame, const std::string& category, const std::vector<std::string>& collsToWrite);
+
+  /// Write all queued Frames, stop the I/O thread and write the current file,
+  /// including all the necessary metadata to read it again.
+  ///
+  /// @throws Any exception that occurred while writing a previous Frame. The
+  /// file is finished nevertheless.
+  void finish();
+
+  /// Get the statistics about the Frames that have been written so far
+  AsyncWriterStatistics getStatistics() const;
+
+private:
+  /// A Frame that is waiting to be written
+  struct QueuedFrame {
+    podio::Frame frame;
+    std::string category;
+    std::vector<std::string> collsToWrite;
+  };
+
+  /// The loop that runs on the I/O thread
+  void run();
+
+  /// Wait until all queued Frames have been written and the I/O thread is idle
+  void waitForDrain(std::unique_lock<std::mutex>& lock);
+
+  /// Rethrow (and reset) the exception from the I/O thread if there is one
+  void rethrowError();
+
+  /// Make sure that finish has not yet been called
+  void checkNotFinished() const;
+
+  podio::Writer m_writer;               ///< The writer that does the actual writing
+  size_t m_queueSize{defaultQueueSize}; ///< The maximum number of queued Frames
+  std::deque<QueuedFrame> m_queue{};    ///< The Frames that are waiting to be written
+  bool m_busy{false};                   ///< Whether the I/O thread is currently writing a Frame
+  bool m_stop{false};                   ///< Whether the I/O thread should stop once the queue is empty
+  bool m_finished{false};               ///< Whether finish has been called already
+  std::exception_ptr m_error{nullptr};  ///< The exception that occurred on the I/O thread
+  AsyncWriterStatistics m_stats{};      ///< The statistics about the written Frames
+  mutable std::mutex m_mtx{};           ///< Guards all of the above (apart from the writer)
+  std::condition_variable m_cv{};       ///< Signals changes of the queue and of the state of the I/O thread
+  std::thread m_thread{};               ///< The I/O thread
+};
+
+/// Create a Writer that writes Frames on a background I/O thread.
+///
+/// This simply wraps the writer that makeWriter creates into an AsyncWriter.
+/// Frames that should be queued have to be moved into the Writer, i.e.
+/// writer.writeFrame(std::move(frame), category).
+///
+/// @param filename  The filename of the output file that will be created.
+/// @param type      The (optional) type argument, see makeWriter
+/// @param options   The (optional) options for writing, see makeWriter
+/// @param queueSize The maximum number of Frames that can be queued
+///
+/// @returns A fully initialized Writer that writes asynchronously
+///
+/// @throws std::runtime_error In case makeWriter throws
+Writer makeAsyncWriter(const std::string& filename, const std::string& type = "default",
+                       const WriterOptions& options = {}, size_t queueSize = AsyncWriter::defaultQueueSize);
+
+} // namespace podio
+
+#endif // PODIO_ASYNCWRITER_H
@@ -4,6 +4,7 @@
 #include "podio/ObjectID.h"
 #include "podio/SchemaEvolution.h"
 
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <string>
@@ -28,6 +29,7 @@ struct CollectionWriteBuffers {
   void* vecPtr{nullptr};
   CollRefCollection* references{nullptr};
   VectorMembersInfo* vectorMembers{nullptr};
+  std::size_t nBytes{0}; ///< The total size of the contents of all buffers in bytes
 
   template <typename DataT>
   std::vector<DataT>* dataAsVector() {
@@ -39,6 +41,15 @@ struct CollectionWriteBuffers {
     // Are we at a beach? I can almost smell the C...
     return *static_cast<std::vector<T>**>(raw);
   }
+
+  /// Get the total size of the ObjectIDs in the passed references in bytes
+  static std::size_t referencesSize(const CollRefCollection& references) {
+    std::size_t size = 0;
+    for (const auto& refs : references) {
+      size += refs->size() * sizeof(podio::ObjectID);
+    }
+    return size;
+  }
 };
 
 struct CollectionReadBuffers {
@@ -106,6 +117,9 @@ struct CollectionReadBuffers {
   // datatype where we have the necessary type information (from code
   // generation) to do the second cast and assign the result of that to the data
   // field again.
+  //
+  // NOTE: The readers that ship with podio pass the addresses of the buffer
+  // pointers to ROOT and no longer need this. It is kept for compatibility
   RecastFuncT recast{};
 
   // Workaround for https://github.com/AIDASoft/podio/issues/500
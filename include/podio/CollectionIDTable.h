@@ -1,11 +1,13 @@
 #ifndef PODIO_COLLECTIONIDTABLE_H
 #define PODIO_COLLECTIONIDTABLE_H
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
-#include <mutex>
 #include <optional>
+#include <shared_mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace podio {
@@ -26,12 +28,28 @@ public:
 
   CollectionIDTable(const std::vector<uint32_t>& ids, const std::vector<std::string>& names);
 
+  /// Create an immutable table from an existing ID:name mapping. Looking up
+  /// names or IDs in an immutable table does not require any locking
+  static std::shared_ptr<const CollectionIDTable> makeImmutable(std::vector<uint32_t>&& ids,
+                                                                std::vector<std::string>&& names);
+
+  /// Create a (mutable) copy of this table. A copy of an immutable table shares
+  /// the lookup index of the original and only indexes the entries that are
+  /// added to it later on
+  CollectionIDTable copy() const;
+
   /// return collection ID for given name
   std::optional<uint32_t> collectionID(const std::string& name) const;
 
   /// return name for given collection ID
   std::optional<const std::string> name(uint32_t collectionID) const;
 
+  /// return the position of the collection with the given name in the table
+  ///
+  /// The position of a collection does not change once it has been added, and
+  /// all copies of a table share the positions of the original
+  std::optional<size_t> index(const std::string& name) const;
+
   /// Check if collection name is known
   bool present(const std::string& name) const;
 
@@ -60,10 +78,47 @@ public:
     return m_names.empty();
   }
 
+  /// Is this an immutable table, i.e. one that has been created via makeImmutable
+  bool isImmutable() const {
+    return m_immutable;
+  }
+
 private:
+  /// Hash based lookup of the position of an ID or a name in the table
+  struct Index {
+    std::unordered_map<uint32_t, size_t> ids{};
+    std::unordered_map<std::string, size_t> names{};
+  };
+
+  /// Add the entry at the given position to the (non-shared) index
+  void addToIndex(size_t index) const;
+
+  /// Check whether all entries are in the index. Tables that have been read
+  /// via ROOT I/O only have their persistent members filled
+  bool indexComplete() const {
+    return m_nIndexed == std::min(m_names.size(), m_collectionIDs.size());
+  }
+
+  /// Add all entries that are not yet in the index. Needs an exclusive lock
+  void completeIndex() const;
+
+  /// Find the position of an ID in the table
+  std::optional<size_t> find(uint32_t collectionID) const;
+
+  /// Find the position of a name in the table
+  std::optional<size_t> find(const std::string& name) const;
+
+  /// Get a lock for reading. Immutable tables do not need to lock. Completes
+  /// the index first if necessary
+  std::shared_lock<std::shared_mutex> readLock() const;
+
   std::vector<uint32_t> m_collectionIDs{};
   std::vector<std::string> m_names{};
-  mutable std::unique_ptr<std::mutex> m_mutex{nullptr};
+  std::shared_ptr<const Index> m_sharedIndex{nullptr}; ///< The index of an immutable table, shared with its copies
+  mutable Index m_index{};                             ///< The index of all entries not in the shared index
+  mutable size_t m_nIndexed{0};                        ///< The number of entries that are in the index
+  bool m_immutable{false};
+  mutable std::unique_ptr<std::shared_mutex> m_mutex{nullptr};
 };
 
 } // namespace podio
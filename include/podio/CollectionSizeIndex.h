@@ -0,0 +1,32 @@
+#ifndef PODIO_COLLECTIONSIZEINDEX_H
+#define PODIO_COLLECTIONSIZEINDEX_H
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace podio {
+
+/// Information about the size of a collection that is available without
+/// reading or unpacking the collection itself.
+///
+/// All writers store the number of elements and the size of the I/O buffers of
+/// every collection alongside the data of each Frame. Together with the type
+/// information that is stored in the metadata of each backend, this makes up
+/// the collection size index of a Frame.
+struct CollectionSizeInfo {
+  std::string valueType{}; ///< The value type of the collection
+  std::size_t elements{0}; ///< The number of elements in the collection
+  /// The (uncompressed) size of all I/O buffers of the collection in bytes.
+  /// Unknown for collections that are not in a collection size index
+  std::optional<std::size_t> bytes{};
+};
+
+/// The collection size index of a Frame, mapping collection names to their
+/// size information
+using CollectionSizeIndex = std::unordered_map<std::string, CollectionSizeInfo>;
+
+} // namespace podio
+
+#endif // PODIO_COLLECTIONSIZEINDEX_H
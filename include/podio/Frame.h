@@ -3,12 +3,16 @@
 
 #include "podio/CollectionBase.h"
 #include "podio/CollectionIDTable.h"
+#include "podio/CollectionSizeIndex.h"
 #include "podio/FrameCategories.h" // mainly for convenience
 #include "podio/GenericParameters.h"
 #include "podio/ICollectionProvider.h"
 #include "podio/SchemaEvolution.h"
+#include "podio/utilities/ThreadPool.h"
 #include "podio/utilities/TypeHelpers.h"
 
+#include <atomic>
+#include <condition_variable>
 #include <initializer_list>
 #include <memory>
 #include <mutex>
@@ -59,6 +63,52 @@ std::optional<podio::CollectionReadBuffers> unpack(FrameDataT* data, const std::
   return data->getCollectionBuffers(name);
 }
 
+/// A handle for repeatedly getting a collection of a given type from Frames.
+///
+/// A token is obtained once via Frame::getToken and records the position of
+/// the collection in the CollectionIDTable of that Frame. All Frames that have
+/// been read via the same reader and for the same category share this table,
+/// such that the token can be used to get the collection from each of them
+/// without any lookups by name or dynamic_casts. For other Frames getting a
+/// collection via a token falls back to getting it by name.
+template <CollectionType CollT>
+class CollectionToken {
+public:
+  /// Create an invalid token that does not refer to any collection
+  CollectionToken() = default;
+
+  /// Check whether this token refers to a collection
+  bool isValid() const {
+    return !m_name.empty();
+  }
+
+  /// The name of the collection
+  const std::string& name() const {
+    return m_name;
+  }
+
+  /// The ID of the collection
+  uint32_t collectionID() const {
+    return m_collectionID;
+  }
+
+  /// The position of the collection in the CollectionIDTable
+  size_t index() const {
+    return m_index;
+  }
+
+private:
+  friend class Frame;
+
+  CollectionToken(std::string name, uint32_t collectionID, size_t index) :
+      m_name(std::move(name)), m_collectionID(collectionID), m_index(index) {
+  }
+
+  std::string m_name{};
+  uint32_t m_collectionID{0};
+  size_t m_index{0};
+};
+
 /// The Frame is a generalized (event) data container that aggregates all
 /// relevant data.
 ///
@@ -70,12 +120,18 @@ class Frame {
   struct FrameConcept {
     virtual ~FrameConcept() = default;
     virtual const podio::CollectionBase* get(const std::string& name) const = 0;
+    virtual bool getFromSlot(size_t index, uint32_t collectionID, const std::string& name,
+                             const podio::CollectionBase*& collection) const = 0;
     virtual const podio::CollectionBase* put(std::unique_ptr<podio::CollectionBase> coll, const std::string& name) = 0;
     virtual podio::GenericParameters& parameters() = 0;
     virtual const podio::GenericParameters& parameters() const = 0;
 
     virtual std::vector<std::string> availableCollections() const = 0;
 
+    virtual std::optional<podio::CollectionSizeInfo> collectionSize(const std::string& name) const = 0;
+
+    virtual void prefetch(const std::vector<std::string>& names, podio::utils::ThreadPool& pool) const = 0;
+
     // Writing interface. Need this to be able to store all necessary information
     // TODO: Figure out whether this can be "hidden" somehow
     virtual podio::CollectionIDTable getIDTable() const = 0;
@@ -97,6 +153,14 @@ class Frame {
     /// pointer to it if found. Otherwise return a nullptr
     const podio::CollectionBase* get(const std::string& name) const final;
 
+    /// Get the collection at the given position of the collection ID table.
+    /// Returns false if the collection at this position does not have the
+    /// passed collectionID, in which case the collection has to be obtained by
+    /// name. Otherwise the collection (or a nullptr if it is not available) is
+    /// returned via the collection argument
+    bool getFromSlot(size_t index, uint32_t collectionID, const std::string& name,
+                     const podio::CollectionBase*& collection) const final;
+
     /// Try and place the collection into the internal storage and return a
     /// pointer to it. If a collection already exists or insertion fails, return
     /// a nullptr
@@ -115,16 +179,58 @@ class Frame {
 
     podio::CollectionIDTable getIDTable() const override {
       // Make a copy
-      return {m_idTable.ids(), m_idTable.names()};
+      return m_idTable.copy();
     }
 
     std::vector<std::string> availableCollections() const override;
 
+    /// Get the size information of a collection from the collection size index
+    /// of the raw data if possible. Otherwise get the collection and determine
+    /// its size information directly
+    std::optional<podio::CollectionSizeInfo> collectionSize(const std::string& name) const override;
+
+    /// Unpack the collections with the passed names, as well as all the
+    /// collections they have relations to, using the threads of the pool
+    void prefetch(const std::vector<std::string>& names, podio::utils::ThreadPool& pool) const override;
+
   private:
-    podio::CollectionBase* doGet(const std::string& name, bool setReferences = true) const;
+    /// Get a collection from the internal map or unpack it from the raw data.
+    /// Collections that are being unpacked by other threads are waited for. If
+    /// waitForReferences is true, this also waits until their references have
+    /// been resolved. This has to be false when resolving references, since
+    /// that might run into cycles otherwise
+    podio::CollectionBase* doGet(const std::string& name, bool setReferences = true,
+                                 bool waitForReferences = true) const;
+
+    /// Get the buffers for a collection from the raw data, unless it is already
+    /// in the internal map, being unpacked or not available. Collections for
+    /// which buffers are returned are marked as being unpacked, see
+    /// finishUnpacking
+    std::optional<podio::CollectionReadBuffers> unpackBuffers(const std::string& name) const;
+
+    /// Get the buffers for a collection that has already been marked as being
+    /// unpacked from the raw data. The mark is removed if they are not available
+    std::optional<podio::CollectionReadBuffers> takeBuffers(const std::string& name) const;
+
+    /// Remove the unpacking and resolving marks from the collections with the
+    /// passed names and wake up all threads that are waiting for them. This has
+    /// to happen once they are in the internal map and their references have
+    /// been resolved (or if unpacking fails)
+    void finishUnpacking(const std::vector<std::string>& names) const;
+
+    /// Create a collection from its buffers, doing schema evolution if
+    /// necessary, and prepare it after reading
+    std::unique_ptr<podio::CollectionBase> createCollection(const std::string& name,
+                                                            podio::CollectionReadBuffers buffers) const;
 
     using CollectionMapT = std::unordered_map<std::string, std::unique_ptr<podio::CollectionBase>>;
 
+    /// The cached collection for one position of the collection ID table
+    struct CollectionSlot {
+      uint32_t collectionID{0};
+      std::atomic<podio::CollectionBase*> collection{nullptr};
+    };
+
     mutable CollectionMapT m_collections{};                 ///< The internal map for storing unpacked collections
     mutable std::unique_ptr<std::mutex> m_mapMtx{nullptr};  ///< The mutex for guarding the internal collection map
     std::unique_ptr<FrameDataT> m_data{nullptr};            ///< The raw data read from file
@@ -133,6 +239,15 @@ class Frame {
     std::unique_ptr<podio::GenericParameters> m_parameters{nullptr}; ///< The generic parameter store for this frame
     mutable std::set<uint32_t> m_retrievedIDs{}; ///< The IDs of the collections that we have already read (but not yet
                                                  ///< put into the map)
+    mutable std::set<std::string> m_unpacking{}; ///< The collections that have been taken from the raw data, but that
+                                                 ///< are not yet in the internal map (guarded by the map mutex)
+    mutable std::set<std::string> m_resolving{}; ///< The collections in the internal map whose references are not yet
+                                                 ///< resolved (guarded by the map mutex)
+    mutable std::unique_ptr<std::condition_variable> m_unpackedCV{nullptr}; ///< Notified when collections have been
+                                                                            ///< unpacked
+    std::unique_ptr<CollectionSlot[]> m_slots{nullptr}; ///< The cached collections for the initial collection ID table
+    size_t m_nSlots{0};                                 ///< The number of cached collections
+    podio::CollectionSizeIndex m_collSizes{}; ///< The collection size index of the raw data (if available)
   };
 
   std::unique_ptr<FrameConcept> m_self; ///< The internal concept pointer through which all the work is done
@@ -199,6 +314,36 @@ public:
   ///          if it is not
   const podio::CollectionBase* get(const std::string& name) const;
 
+  /// Get a token for getting a collection of the given type from this Frame,
+  /// as well as from all the other Frames that have been read via the same
+  /// reader and for the same category.
+  ///
+  /// @note This will unpack the collection in order to check its type
+  ///
+  /// @tparam CollT The type of the desired collection
+  /// @param  name  The name of the collection
+  ///
+  /// @returns      A token for the collection, or an invalid token if no
+  ///               collection with this name is known to the Frame
+  ///
+  /// @throws std::invalid_argument if the collection is not of type CollT
+  template <CollectionType CollT>
+  CollectionToken<CollT> getToken(const std::string& name) const;
+
+  /// Get a collection from the Frame via a token.
+  ///
+  /// Once the collection has been unpacked this does not need any lookups by
+  /// name or dynamic_casts for Frames that have been read via the same reader
+  /// and for the same category as the one that was used to obtain the token.
+  ///
+  /// @tparam CollT The type of the desired collection
+  /// @param  token The token for the collection
+  ///
+  /// @returns      A const reference to the collection if it is available or to
+  ///               an empty (static) collection
+  template <CollectionType CollT>
+  const CollT& get(const CollectionToken<CollT>& token) const;
+
   /// (Destructively) move a collection into the Frame and get a reference to
   /// the inserted collection back for further use.
   ///
@@ -310,6 +455,75 @@ public:
     return m_self->availableCollections();
   }
 
+  /// Get the value type, the number of elements and the size of the buffers of
+  /// a collection.
+  ///
+  /// For collections that have been read with a reader that provides a
+  /// collection size index this does not need to unpack the collection.
+  /// Otherwise the collection is obtained from the Frame in order to determine
+  /// its size. The size of the buffers is unknown in this case, since it is
+  /// only determined when the collection is prepared for writing.
+  ///
+  /// @param name The name of the collection
+  ///
+  /// @returns The size information of the collection or an empty optional if
+  ///          the collection is not available
+  std::optional<podio::CollectionSizeInfo> getCollectionSize(const std::string& name) const {
+    return m_self->collectionSize(name);
+  }
+
+  /// Unpack the collections with the given names and all the collections they
+  /// have relations to.
+  ///
+  /// Collections that do not depend on each other are unpacked concurrently.
+  /// Afterwards getting these collections from the Frame no longer has to do
+  /// any unpacking work. Collections that are not available or have already
+  /// been unpacked are ignored. It is safe to get collections from other
+  /// threads while this is running, they wait for the collections that are
+  /// being unpacked.
+  ///
+  /// The unpacking runs on the process wide podio::utils::sharedThreadPool
+  /// with the requested number of threads, i.e. no threads are started for
+  /// the single calls.
+  ///
+  /// @param names    The names of the collections to unpack
+  /// @param nThreads The number of threads to use for unpacking. The default
+  ///                 (0) uses the available hardware concurrency
+  void prefetch(const std::vector<std::string>& names, unsigned nThreads = 0) const {
+    m_self->prefetch(names, podio::utils::sharedThreadPool(nThreads));
+  }
+
+  /// Unpack the collections with the given names and all the collections they
+  /// have relations to, using the threads of the passed pool.
+  ///
+  /// See prefetch above for more details
+  ///
+  /// @param names The names of the collections to unpack
+  /// @param pool  The pool on which the collections are unpacked
+  void prefetch(const std::vector<std::string>& names, podio::utils::ThreadPool& pool) const {
+    m_self->prefetch(names, pool);
+  }
+
+  /// Unpack all collections that are still available in the raw data.
+  ///
+  /// See prefetch for more details
+  ///
+  /// @param nThreads The number of threads to use for unpacking. The default
+  ///                 (0) uses the available hardware concurrency
+  void prefetchAll(unsigned nThreads = 0) const {
+    m_self->prefetch(m_self->availableCollections(), podio::utils::sharedThreadPool(nThreads));
+  }
+
+  /// Unpack all collections that are still available in the raw data, using
+  /// the threads of the passed pool.
+  ///
+  /// See prefetch for more details
+  ///
+  /// @param pool The pool on which the collections are unpacked
+  void prefetchAll(podio::utils::ThreadPool& pool) const {
+    m_self->prefetch(m_self->availableCollections(), pool);
+  }
+
   /// Get the name of the passed collection
   ///
   /// @param coll The collection for which the name should be obtained
@@ -386,6 +600,32 @@ inline const podio::CollectionBase* Frame::get(const std::string& name) const {
   return m_self->get(name);
 }
 
+template <CollectionType CollT>
+CollectionToken<CollT> Frame::getToken(const std::string& name) const {
+  const auto idTable = m_self->getIDTable();
+  const auto index = idTable.index(name);
+  if (!index) {
+    return {};
+  }
+
+  if (const auto* coll = m_self->get(name); coll && !dynamic_cast<const CollT*>(coll)) {
+    throw std::invalid_argument("Collection " + name + " has type " + std::string(coll->getTypeName()) +
+                                " which does not match the type of the requested token");
+  }
+
+  return {name, idTable.ids()[index.value()], index.value()};
+}
+
+template <CollectionType CollT>
+const CollT& Frame::get(const CollectionToken<CollT>& token) const {
+  const podio::CollectionBase* coll = nullptr;
+  // The type has been checked when creating the token
+  if (token.isValid() && m_self->getFromSlot(token.m_index, token.m_collectionID, token.m_name, coll) && coll) {
+    return *static_cast<const CollT*>(coll);
+  }
+  return get<CollT>(token.name());
+}
+
 inline void Frame::put(std::unique_ptr<podio::CollectionBase> coll, const std::string& name) {
   const auto* retColl = m_self->put(std::move(coll), name);
   if (!retColl) {
@@ -406,7 +646,9 @@ const CollT& Frame::put(CollT&& coll, const std::string& name) {
 
 template <typename FrameDataT>
 Frame::FrameModel<FrameDataT>::FrameModel(std::unique_ptr<FrameDataT> data) :
-    m_mapMtx(std::make_unique<std::mutex>()), m_dataMtx(std::make_unique<std::mutex>()) {
+    m_mapMtx(std::make_unique<std::mutex>()),
+    m_dataMtx(std::make_unique<std::mutex>()),
+    m_unpackedCV(std::make_unique<std::condition_variable>()) {
   if (!data) {
     throw std::invalid_argument(
         "FrameData is a nullptr. If you are reading from a file it may be corrupted or you may reading beyond the end "
@@ -415,6 +657,16 @@ Frame::FrameModel<FrameDataT>::FrameModel(std::unique_ptr<FrameDataT> data) :
   m_data = std::move(data);
   m_idTable = std::move(m_data->getIDTable());
   m_parameters = std::move(m_data->getParameters());
+  if constexpr (requires { m_data->getCollectionSizes(); }) {
+    m_collSizes = m_data->getCollectionSizes();
+  }
+
+  const auto& ids = m_idTable.ids();
+  m_nSlots = ids.size();
+  m_slots = std::make_unique<CollectionSlot[]>(m_nSlots);
+  for (size_t i = 0; i < m_nSlots; ++i) {
+    m_slots[i].collectionID = ids[i];
+  }
 }
 
 template <typename FrameDataT>
@@ -423,57 +675,213 @@ const podio::CollectionBase* Frame::FrameModel<FrameDataT>::get(const std::strin
 }
 
 template <typename FrameDataT>
-podio::CollectionBase* Frame::FrameModel<FrameDataT>::doGet(const std::string& name, bool setReferences) const {
+bool Frame::FrameModel<FrameDataT>::getFromSlot(size_t index, uint32_t collectionID, const std::string& name,
+                                                const podio::CollectionBase*& collection) const {
+  if (index >= m_nSlots || m_slots[index].collectionID != collectionID) {
+    return false;
+  }
+
+  auto& slot = m_slots[index];
+  collection = slot.collection.load(std::memory_order_acquire);
+  if (!collection) {
+    // Concurrent calls all end up with the same collection from doGet, so it
+    // does not matter which one stores it
+    auto* coll = doGet(name);
+    slot.collection.store(coll, std::memory_order_release);
+    collection = coll;
+  }
+  return true;
+}
+
+template <typename FrameDataT>
+podio::CollectionBase* Frame::FrameModel<FrameDataT>::doGet(const std::string& name, bool setReferences,
+                                                             bool waitForReferences) const {
+  // First check whether the collection is in the map already
+  //
+  // Collections only land here if they are fully unpacked, i.e.
+  // prepareAfterRead has been called or it has been put into the Frame.
+  // Collections that are currently being unpacked by another thread are
+  // neither in the map nor in the raw data, so we have to wait for them
   {
-    // First check whether the collection is in the map already
-    //
-    // Collections only land here if they are fully unpacked, i.e.
-    // prepareAfterRead has been called or it has been put into the Frame
-    std::lock_guard lock{*m_mapMtx};
+    std::unique_lock lock{*m_mapMtx};
+    m_unpackedCV->wait(lock, [&]() {
+      return !m_unpacking.contains(name) && !(waitForReferences && m_resolving.contains(name));
+    });
     if (const auto it = m_collections.find(name); it != m_collections.end()) {
       return it->second.get();
     }
+    if (!m_data) {
+      return nullptr;
+    }
+    m_unpacking.insert(name);
+  }
+
+  // Now try to get it from the raw data
+  auto buffers = takeBuffers(name);
+  if (!buffers) {
+    return nullptr;
   }
 
   podio::CollectionBase* retColl = nullptr;
+  try {
+    auto coll = createCollection(name, buffers.value());
+    std::lock_guard mapLock{*m_mapMtx};
+    auto [it, success] = m_collections.emplace(name, std::move(coll));
+    // TODO: Check success? Or simply assume that everything is fine at this point?
+    // TODO: Collision handling?
+    retColl = it->second.get();
+    m_unpacking.erase(name);
+    if (setReferences) {
+      m_resolving.insert(name);
+    }
+  } catch (...) {
+    finishUnpacking({name});
+    throw;
+  }
+  m_unpackedCV->notify_all();
+
+  if (setReferences) {
+    try {
+      retColl->setReferences(this);
+    } catch (...) {
+      finishUnpacking({name});
+      throw;
+    }
+    finishUnpacking({name});
+  }
 
-  // Now try to get it from the raw data if we have the possibility
-  if (m_data) {
-    // Have the buffers in the outer scope here to hold the raw data lock as
-    // briefly as possible
-    auto buffers = std::optional<podio::CollectionReadBuffers>{std::nullopt};
-    {
-      std::lock_guard lock{*m_dataMtx};
-      buffers = unpack(m_data.get(), name);
+  return retColl;
+}
+
+template <typename FrameDataT>
+void Frame::FrameModel<FrameDataT>::finishUnpacking(const std::vector<std::string>& names) const {
+  {
+    std::lock_guard lock{*m_mapMtx};
+    for (const auto& name : names) {
+      m_unpacking.erase(name);
+      m_resolving.erase(name);
     }
-    if (buffers) {
-      std::unique_ptr<podio::CollectionBase> coll{nullptr};
-      // Subset collections do not need schema evolution (by definition)
-      if (buffers->data == nullptr) {
-        coll = buffers->createCollection(buffers.value(), true);
-      } else {
-        auto evolvedBuffers = podio::SchemaEvolution::instance().evolveBuffers(buffers.value(), buffers->schemaVersion,
-                                                                               std::string(buffers->type));
-        coll = evolvedBuffers.createCollection(evolvedBuffers, false);
-      }
+  }
+  m_unpackedCV->notify_all();
+}
 
-      coll->prepareAfterRead();
-      coll->setID(m_idTable.collectionID(name).value());
-      {
-        std::lock_guard mapLock{*m_mapMtx};
-        auto [it, success] = m_collections.emplace(name, std::move(coll));
-        // TODO: Check success? Or simply assume that everything is fine at this point?
-        // TODO: Collision handling?
-        retColl = it->second.get();
+template <typename FrameDataT>
+std::unique_ptr<podio::CollectionBase>
+Frame::FrameModel<FrameDataT>::createCollection(const std::string& name, podio::CollectionReadBuffers buffers) const {
+  std::unique_ptr<podio::CollectionBase> coll{nullptr};
+  // Subset collections do not need schema evolution (by definition)
+  if (buffers.data == nullptr) {
+    coll = buffers.createCollection(buffers, true);
+  } else {
+    auto evolvedBuffers =
+        podio::SchemaEvolution::instance().evolveBuffers(buffers, buffers.schemaVersion, std::string(buffers.type));
+    coll = evolvedBuffers.createCollection(evolvedBuffers, false);
+  }
+
+  coll->prepareAfterRead();
+  coll->setID(m_idTable.collectionID(name).value());
+  return coll;
+}
+
+template <typename FrameDataT>
+std::optional<podio::CollectionReadBuffers>
+Frame::FrameModel<FrameDataT>::unpackBuffers(const std::string& name) const {
+  {
+    std::lock_guard lock{*m_mapMtx};
+    if (!m_data || m_collections.contains(name) || !m_unpacking.insert(name).second) {
+      return std::nullopt;
+    }
+  }
+  return takeBuffers(name);
+}
+
+template <typename FrameDataT>
+std::optional<podio::CollectionReadBuffers> Frame::FrameModel<FrameDataT>::takeBuffers(const std::string& name) const {
+  // Only hold the raw data lock for unpacking, since that might involve some
+  // work (e.g. decompression). Other threads wait for the collection to appear
+  // in the map
+  auto buffers = std::optional<podio::CollectionReadBuffers>{std::nullopt};
+  try {
+    std::lock_guard lock{*m_dataMtx};
+    buffers = unpack(m_data.get(), name);
+  } catch (...) {
+    finishUnpacking({name});
+    throw;
+  }
+  if (!buffers) {
+    finishUnpacking({name});
+  }
+  return buffers;
+}
+
+template <typename FrameDataT>
+void Frame::FrameModel<FrameDataT>::prefetch(const std::vector<std::string>& names,
+                                             podio::utils::ThreadPool& pool) const {
+  // Get the buffers of all requested collections and of all the collections
+  // that they point to. The latter are necessary to resolve the relations and
+  // are determined from the ObjectIDs that have been read, which only picks up
+  // the collections that are actually referenced in this Frame
+  std::vector<std::string> unpackNames{};
+  std::vector<podio::CollectionReadBuffers> toUnpack{};
+  std::set<std::string> requested(names.begin(), names.end());
+  std::vector<std::string> pending(requested.begin(), requested.end());
+  std::vector<podio::CollectionBase*> unpacked{};
+  try {
+    while (!pending.empty()) {
+      auto name = std::move(pending.back());
+      pending.pop_back();
+
+      auto buffers = unpackBuffers(name);
+      if (!buffers) {
+        continue;
+      }
+      unpackNames.emplace_back(std::move(name));
+      toUnpack.emplace_back(buffers.value());
+
+      if (buffers->references) {
+        std::set<uint32_t> relatedIDs{};
+        for (const auto& refs : *buffers->references) {
+          for (const auto& id : *refs) {
+            relatedIDs.insert(id.collectionID);
+          }
+        }
+        for (const auto id : relatedIDs) {
+          if (auto relName = m_idTable.name(id); relName && requested.insert(relName.value()).second) {
+            pending.push_back(relName.value());
+          }
+        }
       }
+    }
+
+    // The collections do not depend on each other for unpacking, so all of them
+    // can be done concurrently
+    std::vector<std::unique_ptr<podio::CollectionBase>> collections(toUnpack.size());
+    pool.parallelFor(toUnpack.size(), [&](size_t i) {
+      collections[i] = createCollection(unpackNames[i], std::move(toUnpack[i]));
+    });
 
-      if (setReferences) {
-        retColl->setReferences(this);
+    unpacked.reserve(collections.size());
+    {
+      std::lock_guard lock{*m_mapMtx};
+      for (size_t i = 0; i < collections.size(); ++i) {
+        const auto [it, inserted] = m_collections.try_emplace(unpackNames[i], std::move(collections[i]));
+        if (inserted) {
+          unpacked.push_back(it->second.get());
+          m_resolving.insert(unpackNames[i]);
+        }
+        m_unpacking.erase(unpackNames[i]);
       }
     }
+    m_unpackedCV->notify_all();
+
+    // Now that all related collections are available, the references can be
+    // resolved concurrently as well
+    pool.parallelFor(unpacked.size(), [&](size_t i) { unpacked[i]->setReferences(this); });
+  } catch (...) {
+    finishUnpacking(unpackNames);
+    throw;
   }
-
-  return retColl;
+  finishUnpacking(unpackNames);
 }
 
 template <typename FrameDataT>
@@ -482,16 +890,19 @@ bool Frame::FrameModel<FrameDataT>::get(uint32_t collectionID, CollectionBase*&
   if (!name) {
     return false;
   }
-  const auto& [_, inserted] = m_retrievedIDs.insert(collectionID);
+  const auto inserted = [&]() {
+    std::lock_guard lock{*m_mapMtx};
+    return m_retrievedIDs.insert(collectionID).second;
+  }();
 
   if (inserted) {
-    auto coll = doGet(name.value());
+    auto coll = doGet(name.value(), true, false);
     if (coll) {
       collection = coll;
       return true;
     }
   } else {
-    auto coll = doGet(name.value(), false);
+    auto coll = doGet(name.value(), false, false);
     if (coll) {
       collection = coll;
       return true;
@@ -522,6 +933,22 @@ const podio::CollectionBase* Frame::FrameModel<FrameDataT>::put(std::unique_ptr<
   return nullptr;
 }
 
+template <typename FrameDataT>
+std::optional<podio::CollectionSizeInfo>
+Frame::FrameModel<FrameDataT>::collectionSize(const std::string& name) const {
+  if (const auto it = m_collSizes.find(name); it != m_collSizes.end()) {
+    return it->second;
+  }
+
+  // Collections that have been put into the Frame, or raw data without a
+  // collection size index
+  const auto* coll = doGet(name);
+  if (!coll) {
+    return std::nullopt;
+  }
+  return podio::CollectionSizeInfo{std::string(coll->getValueTypeName()), coll->size(), std::nullopt};
+}
+
 template <typename FrameDataT>
 std::vector<std::string> Frame::FrameModel<FrameDataT>::availableCollections() const {
   // TODO: Check if there is a more efficient way to do this. Currently this is
@@ -5,13 +5,17 @@
 #include "podio/utilities/TypeHelpers.h"
 
 #include <algorithm>
+#include <functional>
 #include <iostream>
 #include <iterator>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <shared_mutex>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #if PODIO_ENABLE_SIO
@@ -41,6 +45,15 @@ concept ValidGenericDataType = isSupportedGenericDataType<T>;
 ///  run, event or collection dependent.
 ///  (based on lcio::LCParameters)
 ///
+/// All parameters of one type are stored in flat vectors of (sorted) keys and
+/// values. All accesses are synchronized via one reader-writer lock, except
+/// for read-only snapshots (see snapshot()) that do not need any locking.
+///
+/// Single values are stored as vectors with one element rather than inline.
+/// All I/O backends persist exactly one vector of values per key, and keeping
+/// that layout in memory is what allows them to write (see lockedView()) and
+/// read the parameters without converting them.
+///
 /// @author F. Gaede, DESY
 /// @date Apr 2020
 class GenericParameters {
@@ -48,9 +61,59 @@ public:
   template <typename T>
   using MapType = std::map<std::string, std::vector<T>>;
 
+  /// The storage for all parameters of one type. The keys are kept sorted and
+  /// the values are stored at the same index as their key. This is also the
+  /// layout in which the ROOT based backends store the parameters, so that
+  /// writers can use it directly.
+  template <typename T>
+  struct Storage {
+    std::vector<std::string> keys{};      ///< The keys in sorted order
+    std::vector<std::vector<T>> values{}; ///< The values for each key
+
+    /// Get the values that are stored under the given key or a nullptr if
+    /// there are none
+    const std::vector<T>* find(std::string_view key) const {
+      const auto it = std::ranges::lower_bound(keys, key);
+      if (it == keys.end() || *it != key) {
+        return nullptr;
+      }
+      return &values[std::distance(keys.begin(), it)];
+    }
+
+    /// Get the values that are stored under the given key, inserting empty
+    /// values if there are none yet
+    std::vector<T>& getOrInsert(std::string_view key) {
+      // Keys that come in sorted order (e.g. when reading) are simply appended
+      if (keys.empty() || keys.back() < key) {
+        keys.emplace_back(key);
+        return values.emplace_back();
+      }
+      const auto it = std::ranges::lower_bound(keys, key);
+      const auto index = std::distance(keys.begin(), it);
+      if (*it != key) {
+        keys.emplace(it, key);
+        values.emplace(values.begin() + index);
+      }
+      return values[index];
+    }
+
+    size_t size() const {
+      return keys.size();
+    }
+
+    bool empty() const {
+      return keys.empty();
+    }
+
+    void clear() {
+      keys.clear();
+      values.clear();
+    }
+  };
+
 private:
-  // need mutex pointers for having the possibility to copy/move GenericParameters
-  using MutexPtr = std::unique_ptr<std::mutex>;
+  // need a mutex pointer for having the possibility to copy/move GenericParameters
+  using MutexPtr = std::unique_ptr<std::shared_mutex>;
 
 public:
   GenericParameters();
@@ -61,12 +124,54 @@ public:
   GenericParameters(const GenericParameters&);
   GenericParameters& operator=(const GenericParameters&) = delete;
 
-  /// GenericParameters are default moveable
-  GenericParameters(GenericParameters&&) = default;
-  GenericParameters& operator=(GenericParameters&&) = default;
+  /// GenericParameters are moveable. The moved-from parameters are left empty
+  /// and can be changed again, even if they have been a read-only snapshot
+  GenericParameters(GenericParameters&&);
+  GenericParameters& operator=(GenericParameters&&);
 
   ~GenericParameters() = default;
 
+  /// Create a read-only copy of the current parameters.
+  ///
+  /// Since a snapshot can no longer change, reading from it does not need any
+  /// locking. Trying to change it throws a std::logic_error. Copies of a
+  /// snapshot can be changed again.
+  GenericParameters snapshot() const;
+
+  /// Check whether these parameters are a read-only snapshot
+  bool isReadOnly() const {
+    return m_mtx == nullptr;
+  }
+
+  /// A view of the storage of GenericParameters that holds a read lock on
+  /// them for as long as it exists, such that the storage cannot change while
+  /// it is in use.
+  class LockedView {
+  public:
+    /// Get the storage for all parameters of the given type
+    template <ValidGenericDataType T>
+    const Storage<detail::GetVectorType<T>>& getStorage() const {
+      return m_params->getStorage<T>();
+    }
+
+  private:
+    friend class GenericParameters;
+    explicit LockedView(const GenericParameters& params) : m_params(&params), m_lock(params.readLock()) {
+    }
+
+    const GenericParameters* m_params;
+    std::shared_lock<std::shared_mutex> m_lock;
+  };
+
+  /// Get a read-locked view of the parameters. Writers use this to write the
+  /// parameters without copying them first.
+  ///
+  /// @note Changing the parameters blocks until the view has been destroyed,
+  /// i.e. they must not be changed on the thread holding the view
+  LockedView lockedView() const {
+    return LockedView(*this);
+  }
+
   template <ValidGenericDataType T>
   std::optional<T> get(const std::string& key) const;
 
@@ -94,6 +199,13 @@ public:
   template <typename T, template <typename...> typename VecLike>
   void loadFrom(VecLike<std::string> keys, VecLike<std::vector<T>> values);
 
+  /// Load all parameters of one type from the passed storage. If there are no
+  /// parameters of this type yet and the keys are sorted (as they are when
+  /// they have been written), the storage is taken over without any copies.
+  /// Otherwise only the values for keys that are not yet present are loaded.
+  template <typename T>
+  void loadFrom(Storage<T> storage);
+
   /// Get the number of elements stored under the given key for a type
   template <ValidGenericDataType T>
   size_t getN(const std::string& key) const;
@@ -106,19 +218,30 @@ public:
   template <ValidGenericDataType T>
   std::tuple<std::vector<std::string>, std::vector<std::vector<T>>> getKeysAndValues() const;
 
+  /// Get a copy of all parameters of a given type as a map
+  ///
+  /// @note The parameters are no longer stored in a map, so this has to copy
+  /// all of them. Use getKeysAndValues, or get for single keys, instead
+  template <typename T>
+  [[deprecated("The parameters are no longer stored in a map, use getKeysAndValues instead")]] MapType<
+      detail::GetVectorType<T>>
+  getMap() const;
+
   /// erase all elements
   void clear() {
-    _intMap.clear();
-    _floatMap.clear();
-    _doubleMap.clear();
-    _stringMap.clear();
+    const auto lock = writeLock();
+    m_intParams.clear();
+    m_floatParams.clear();
+    m_doubleParams.clear();
+    m_stringParams.clear();
   }
 
   void print(std::ostream& os = std::cout, bool flush = true) const;
 
-  /// Check if no parameter is stored (i.e. if all internal maps are empty)
+  /// Check if no parameter is stored (i.e. if all internal storages are empty)
   bool empty() const {
-    return _intMap.empty() && _floatMap.empty() && _doubleMap.empty() && _stringMap.empty();
+    const auto lock = readLock();
+    return m_intParams.empty() && m_floatParams.empty() && m_doubleParams.empty() && m_stringParams.empty();
   }
 
 #if PODIO_ENABLE_SIO
@@ -126,152 +249,161 @@ public:
   friend void readGenericParameters(sio::read_device& device, GenericParameters& parameters, sio::version_type version);
 #endif
 
-  /// Get a reference to the internal map for a given type
+private:
+  /// Get a reference to the internal storage for a given type
   template <typename T>
-  const MapType<detail::GetVectorType<T>>& getMap() const {
+  const Storage<detail::GetVectorType<T>>& getStorage() const {
     if constexpr (std::is_same_v<detail::GetVectorType<T>, int>) {
-      return _intMap;
+      return m_intParams;
     } else if constexpr (std::is_same_v<detail::GetVectorType<T>, float>) {
-      return _floatMap;
+      return m_floatParams;
     } else if constexpr (std::is_same_v<detail::GetVectorType<T>, double>) {
-      return _doubleMap;
+      return m_doubleParams;
     } else {
-      return _stringMap;
+      return m_stringParams;
     }
   }
 
-private:
-  /// Get a reference to the internal map for a given type
+  /// Get a reference to the internal storage for a given type
   template <typename T>
-  MapType<detail::GetVectorType<T>>& getMap() {
+  Storage<detail::GetVectorType<T>>& getStorage() {
     if constexpr (std::is_same_v<detail::GetVectorType<T>, int>) {
-      return _intMap;
+      return m_intParams;
     } else if constexpr (std::is_same_v<detail::GetVectorType<T>, float>) {
-      return _floatMap;
+      return m_floatParams;
     } else if constexpr (std::is_same_v<detail::GetVectorType<T>, double>) {
-      return _doubleMap;
+      return m_doubleParams;
     } else {
-      return _stringMap;
+      return m_stringParams;
     }
   }
 
-  /// Get the mutex that guards the map for the given type
-  template <typename T>
-  std::mutex& getMutex() const {
-    if constexpr (std::is_same_v<detail::GetVectorType<T>, int>) {
-      return *(m_intMtx.get());
-    } else if constexpr (std::is_same_v<detail::GetVectorType<T>, float>) {
-      return *(m_floatMtx.get());
-    } else if constexpr (std::is_same_v<detail::GetVectorType<T>, double>) {
-      return *(m_doubleMtx.get());
-    } else {
-      return *(m_stringMtx.get());
+  /// Put moved-from parameters back into a valid (empty and changeable) state
+  void reset();
+
+  /// Lock for reading. This does nothing for read-only snapshots
+  std::shared_lock<std::shared_mutex> readLock() const {
+    if (m_mtx) {
+      return std::shared_lock{*m_mtx};
+    }
+    return {};
+  }
+
+  /// Lock for writing
+  ///
+  /// @throws std::logic_error for read-only snapshots
+  std::unique_lock<std::shared_mutex> writeLock() {
+    if (!m_mtx) {
+      throw std::logic_error("Read-only GenericParameters cannot be changed");
     }
+    return std::unique_lock{*m_mtx};
   }
 
 private:
-  MapType<int> _intMap{};                ///< The map storing the integer values
-  mutable MutexPtr m_intMtx{nullptr};    ///< The mutex guarding the integer map
-  MapType<float> _floatMap{};            ///< The map storing the float values
-  mutable MutexPtr m_floatMtx{nullptr};  ///< The mutex guarding the float map
-  MapType<std::string> _stringMap{};     ///< The map storing the string values
-  mutable MutexPtr m_stringMtx{nullptr}; ///< The mutex guarding the string map
-  MapType<double> _doubleMap{};          ///< The map storing the double values
-  mutable MutexPtr m_doubleMtx{nullptr}; ///< The mutex guarding the double map
+  Storage<int> m_intParams{};            ///< The storage for the integer values
+  Storage<float> m_floatParams{};        ///< The storage for the float values
+  Storage<std::string> m_stringParams{}; ///< The storage for the string values
+  Storage<double> m_doubleParams{};      ///< The storage for the double values
+  mutable MutexPtr m_mtx{nullptr};       ///< The mutex guarding all storages. Not present for read-only snapshots
 };
 
 template <ValidGenericDataType T>
 std::optional<T> GenericParameters::get(const std::string& key) const {
-  const auto& map = getMap<T>();
-  auto& mtx = getMutex<T>();
-  std::lock_guard lock{mtx};
-  const auto it = map.find(key);
-  if (it == map.end()) {
+  const auto& storage = getStorage<T>();
+  const auto lock = readLock();
+  const auto* values = storage.find(key);
+  if (!values) {
     return std::nullopt;
   }
 
   // We have to check whether the return type is a vector or a single value
   if constexpr (detail::isVector<T>) {
-    return it->second;
+    return *values;
   } else {
-    const auto& iv = it->second;
-    if (iv.empty()) {
+    if (values->empty()) {
       return std::nullopt;
     }
-    return iv[0];
+    return (*values)[0];
   }
 }
 
 template <ValidGenericDataType T>
 void GenericParameters::set(const std::string& key, T value) {
-  auto& map = getMap<T>();
-  auto& mtx = getMutex<T>();
+  auto& storage = getStorage<T>();
+  const auto lock = writeLock();
+  auto& values = storage.getOrInsert(key);
 
   if constexpr (detail::isVector<T>) {
-    std::lock_guard lock{mtx};
-    map.insert_or_assign(key, std::move(value));
+    values = std::move(value);
   } else {
-    // Wrap the value into a vector with exactly one entry and store that
-    std::vector<T> v = {std::move(value)};
-    std::lock_guard lock{mtx};
-    map.insert_or_assign(key, std::move(v));
+    // Single values are stored as a vector with exactly one entry. Re-use the
+    // existing one if possible
+    values.clear();
+    values.emplace_back(std::move(value));
   }
 }
 
 template <ValidGenericDataType T>
 size_t GenericParameters::getN(const std::string& key) const {
-  const auto& map = getMap<T>();
-  auto& mtx = getMutex<T>();
-  std::lock_guard lock{mtx};
-  if (const auto it = map.find(key); it != map.end()) {
-    return it->second.size();
+  const auto& storage = getStorage<T>();
+  const auto lock = readLock();
+  if (const auto* values = storage.find(key)) {
+    return values->size();
   }
   return 0;
 }
 
 template <ValidGenericDataType T>
 std::vector<std::string> GenericParameters::getKeys() const {
-  std::vector<std::string> keys;
-  const auto& map = getMap<T>();
-  keys.reserve(map.size());
-  {
-    auto& mtx = getMutex<T>();
-    std::lock_guard lock{mtx};
-    std::transform(map.begin(), map.end(), std::back_inserter(keys), [](const auto& pair) { return pair.first; });
-  }
+  const auto lock = readLock();
+  return getStorage<T>().keys;
+}
 
-  return keys;
+template <typename T>
+GenericParameters::MapType<detail::GetVectorType<T>> GenericParameters::getMap() const {
+  const auto lock = readLock();
+  const auto& storage = getStorage<T>();
+  MapType<detail::GetVectorType<T>> map{};
+  for (size_t i = 0; i < storage.size(); ++i) {
+    map.emplace_hint(map.end(), storage.keys[i], storage.values[i]);
+  }
+  return map;
 }
 
 template <ValidGenericDataType T>
 std::tuple<std::vector<std::string>, std::vector<std::vector<T>>> GenericParameters::getKeysAndValues() const {
-  std::vector<std::vector<T>> values;
-  std::vector<std::string> keys;
-  auto& mtx = getMutex<T>();
-  const auto& map = getMap<T>();
-  {
-    // Lock to avoid concurrent changes to the map while we get the stored
-    // values
-    std::lock_guard lock{mtx};
-    values.reserve(map.size());
-    keys.reserve(map.size());
-
-    for (const auto& [k, v] : map) {
-      keys.emplace_back(k);
-      values.emplace_back(v);
-    }
-  }
-  return {keys, values};
+  // Lock to avoid concurrent changes while we get the stored values
+  const auto lock = readLock();
+  const auto& storage = getStorage<T>();
+  return {storage.keys, storage.values};
 }
 
 template <typename T, template <typename...> typename VecLike>
 void GenericParameters::loadFrom(VecLike<std::string> keys, VecLike<std::vector<T>> values) {
-  auto& map = getMap<T>();
-  auto& mtx = getMutex<T>();
+  if constexpr (std::is_same_v<VecLike<std::string>, std::vector<std::string>>) {
+    loadFrom(Storage<T>{std::move(keys), std::move(values)});
+  } else {
+    loadFrom(Storage<T>{{std::make_move_iterator(keys.begin()), std::make_move_iterator(keys.end())},
+                        {std::make_move_iterator(values.begin()), std::make_move_iterator(values.end())}});
+  }
+}
+
+template <typename T>
+void GenericParameters::loadFrom(Storage<T> storage) {
+  auto& current = getStorage<T>();
+  const auto lock = writeLock();
+
+  // Sorted and unique keys can be taken over directly
+  if (current.empty() && std::ranges::adjacent_find(storage.keys, std::greater_equal{}) == storage.keys.end()) {
+    current = std::move(storage);
+    return;
+  }
 
-  std::lock_guard lock{mtx};
-  for (size_t i = 0; i < keys.size(); ++i) {
-    map.emplace(std::move(keys[i]), std::move(values[i]));
+  for (size_t i = 0; i < storage.size(); ++i) {
+    // Keep already existing values
+    if (!current.find(storage.keys[i])) {
+      current.getOrInsert(storage.keys[i]) = std::move(storage.values[i]);
+    }
   }
 }
 
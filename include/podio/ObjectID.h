@@ -15,9 +15,9 @@ class ObjectID {
 
 public:
   /// not part of a collection
-  static const int untracked = -1;
+  static constexpr int untracked = -1;
   /// invalid or non-available object
-  static const int invalid = -2;
+  static constexpr int invalid = -2;
 
   /// index of object in collection
   int index{untracked};
@@ -1,11 +1,14 @@
 #ifndef PODIO_RNTUPLEREADER_H
 #define PODIO_RNTUPLEREADER_H
 
+#include "podio/CollectionSizeIndex.h"
 #include "podio/ROOTFrameData.h"
 #include "podio/SchemaEvolution.h"
 #include "podio/podioVersion.h"
 #include "podio/utilities/DatamodelRegistryIOHelpers.h"
 
+#include <cstdint>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -94,6 +97,18 @@ public:
   /// @returns The number of entries that are available for the category
   unsigned getEntries(const std::string& name);
 
+  /// Get the collection size index of an entry, i.e. the value type, the number
+  /// of elements and the size of the buffers of all collections, without
+  /// reading any collection data
+  ///
+  /// @param name  The category name
+  /// @param entry The entry number
+  ///
+  /// @returns The collection size index if the category and the entry exist and
+  ///          if the file has been written with a collection size index.
+  ///          Otherwise an empty optional
+  std::optional<podio::CollectionSizeIndex> getCollectionSizes(const std::string& name, const unsigned entry);
+
   /// Get the build version of podio that has been used to write the current
   /// file
   ///
@@ -137,12 +152,11 @@ private:
   bool initCategory(const std::string& category);
 
   /**
-   * Read and reconstruct the generic parameters of the Frame
+   * Bind the keys and values of the generic parameters of type T to the entry,
+   * such that they are read directly into the passed storage
    */
-  GenericParameters readEventMetaData(const std::string& name, unsigned localEntry, unsigned readerIndex);
-
   template <typename T>
-  void readParams(const std::string& name, unsigned entNum, unsigned readerIndex, GenericParameters& params);
+  static void bindParams(ROOT::Experimental::REntry& entry, GenericParameters::Storage<T>& storage);
 
   std::unique_ptr<ROOT::Experimental::RNTupleReader> m_metadata{};
 
@@ -165,15 +179,25 @@ private:
     std::vector<unsigned int> id{};
     std::vector<std::string> name{};
     std::vector<std::string> type{};
+    std::vector<std::string> valueType{}; ///< Only available in files with a collection size index
     std::vector<short> isSubsetCollection{};
     std::vector<SchemaVersionT> schemaVersion{};
   };
 
   std::unordered_map<std::string, CollectionInfo> m_collectionInfo{};
 
+  /**
+   * Create the collection size index for the collections that should be read
+   * from the number of elements and buffer sizes of all collections
+   */
+  static podio::CollectionSizeIndex makeCollectionSizes(const CollectionInfo& collInfo,
+                                                        const std::vector<uint64_t>& elements,
+                                                        const std::vector<uint64_t>& bytes,
+                                                        const std::vector<std::string>& collsToRead);
+
   std::vector<std::string> m_availableCategories{};
 
-  std::unordered_map<std::string, std::shared_ptr<podio::CollectionIDTable>> m_idTables{};
+  std::unordered_map<std::string, std::shared_ptr<const podio::CollectionIDTable>> m_idTables{};
 };
 
 } // namespace podio
@@ -3,6 +3,7 @@
 
 #include "podio/Frame.h"
 #include "podio/SchemaEvolution.h"
+#include "podio/WriterOptions.h"
 #include "podio/utilities/DatamodelRegistryIOHelpers.h"
 #include "podio/utilities/RootHelpers.h"
 
@@ -32,7 +33,8 @@ public:
   /// @note Existing files will be overwritten without warning.
   ///
   /// @param filename The path to the file that will be created.
-  RNTupleWriter(const std::string& filename);
+  /// @param options  The options for writing, e.g. the compression settings
+  RNTupleWriter(const std::string& filename, const WriterOptions& options = {});
 
   /// RNTupleWriter destructor
   ///
@@ -109,25 +111,23 @@ private:
     std::vector<uint32_t> ids{};                  ///< The ids of all collections
     std::vector<std::string> names{};             ///< The names of all collections
     std::vector<std::string> types{};             ///< The types of all collections
+    std::vector<std::string> valueTypes{};        ///< The value types of all collections
     std::vector<short> subsetCollections{};       ///< The flags identifying the subcollections
     std::vector<SchemaVersionT> schemaVersions{}; ///< The schema versions of all collections
 
-    // Storage for the keys & values of all the parameters of this category
-    // (resp. at least the current entry)
-    root_utils::ParamStorage<int> intParams{};
-    root_utils::ParamStorage<float> floatParams{};
-    root_utils::ParamStorage<double> doubleParams{};
-    root_utils::ParamStorage<std::string> stringParams{};
+    std::vector<uint64_t> collElements{}; ///< The number of elements of all collections of the current entry
+    std::vector<uint64_t> collBytes{};    ///< The buffer sizes of all collections of the current entry
   };
   CategoryInfo& getCategoryInfo(const std::string& category);
 
   template <typename T>
-  void fillParams(const GenericParameters& params, CategoryInfo& catInfo, ROOT::Experimental::REntry* entry);
+  void fillParams(const GenericParameters::LockedView& params, ROOT::Experimental::REntry* entry);
 
-  template <typename T>
-  root_utils::ParamStorage<T>& getParamStorage(CategoryInfo& catInfo);
+  /// Get the RNTuple write options for the given category
+  ROOT::Experimental::RNTupleWriteOptions getWriteOptions(const std::string& category) const;
 
   std::unique_ptr<TFile> m_file{};
+  WriterOptions m_options{};
 
   DatamodelDefinitionCollector m_datamodelCollector{};
 
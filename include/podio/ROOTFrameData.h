@@ -3,6 +3,7 @@
 
 #include "podio/CollectionBuffers.h"
 #include "podio/CollectionIDTable.h"
+#include "podio/CollectionSizeIndex.h"
 #include "podio/GenericParameters.h"
 
 #include <memory>
@@ -25,7 +26,8 @@ public:
   ROOTFrameData(const ROOTFrameData&) = delete;
   ROOTFrameData& operator=(const ROOTFrameData&) = delete;
 
-  ROOTFrameData(BufferMap&& buffers, CollIDPtr&& idTable, podio::GenericParameters&& params);
+  ROOTFrameData(BufferMap&& buffers, CollIDPtr idTable, podio::GenericParameters&& params,
+                podio::CollectionSizeIndex&& collSizes = {});
 
   std::optional<podio::CollectionReadBuffers> getCollectionBuffers(const std::string& name);
 
@@ -35,6 +37,10 @@ public:
 
   std::vector<std::string> getAvailableCollections() const;
 
+  const podio::CollectionSizeIndex& getCollectionSizes() const {
+    return m_collSizes;
+  }
+
 private:
   // TODO: switch to something more elegant once the basic functionality and
   // interface is better defined
@@ -42,6 +48,7 @@ private:
   // This is co-owned by each FrameData and the original reader. (for now at least)
   CollIDPtr m_idTable{nullptr};
   podio::GenericParameters m_parameters{};
+  podio::CollectionSizeIndex m_collSizes{};
 };
 
 } // namespace podio
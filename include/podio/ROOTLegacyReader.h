@@ -128,7 +128,7 @@ private:
   // collection after it has been read the very first time
   std::vector<std::pair<std::string, detail::CollectionInfo>> m_storedClasses{};
 
-  std::shared_ptr<CollectionIDTable> m_table{nullptr};
+  std::shared_ptr<const CollectionIDTable> m_table{nullptr};
   std::unique_ptr<TChain> m_chain{nullptr};
   unsigned m_eventNumber{0};
 
@@ -1,6 +1,7 @@
 #ifndef PODIO_ROOTREADER_H
 #define PODIO_ROOTREADER_H
 
+#include "podio/CollectionSizeIndex.h"
 #include "podio/ROOTFrameData.h"
 #include "podio/podioVersion.h"
 #include "podio/utilities/DatamodelRegistryIOHelpers.h"
@@ -9,6 +10,7 @@
 #include "TChain.h"
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <tuple>
@@ -39,6 +41,16 @@ class CollectionIDTable;
 class GenericParameters;
 struct CollectionReadBuffers;
 
+/// Statistics about the entries that have been read ahead by a ROOTReader with
+/// enabled prefetching
+struct ROOTReaderPrefetchStatistics {
+  size_t queueDepth{0};    ///< The number of entries that are currently ready for all categories
+  size_t maxQueueDepth{0}; ///< The maximum number of entries that were ready at the same time for one category
+  size_t nPrefetched{0};   ///< The number of entries that have been read ahead
+  size_t nDiscarded{0};    ///< The number of entries that have been read ahead but were never used
+  size_t nWaits{0};        ///< The number of times an entry was requested before it was ready
+};
+
 /// This class has the function to read available data from disk in ROOTs TTree
 /// format.
 ///
@@ -48,9 +60,9 @@ class ROOTReader {
 
 public:
   /// Create a ROOTReader
-  ROOTReader() = default;
+  ROOTReader();
   /// Destructor
-  ~ROOTReader() = default;
+  ~ROOTReader();
 
   /// The ROOTReader is not copy-able
   ROOTReader(const ROOTReader&) = delete;
@@ -105,6 +117,32 @@ public:
   std::unique_ptr<podio::ROOTFrameData> readEntry(const std::string& name, const unsigned entry,
                                                   const std::vector<std::string>& collsToRead = {});
 
+  /// Read several consecutive data entries for a given category in one go.
+  ///
+  /// The TTreeCache of the category is set to the requested range and to
+  /// exactly the branches that are read, such that ROOT fetches their baskets
+  /// for all entries with a few large reads, instead of one read per basket
+  /// and entry. The entries themselves are still unpacked one after the other.
+  /// Afterwards the cache is reset, such that later reads are not limited to
+  /// these branches, and readNextEntry continues after the last entry that has
+  /// been read.
+  ///
+  /// @param name  The category name for which to read the entries
+  /// @param first The first entry number to read
+  /// @param count The number of entries to read
+  /// @param collsToRead (optional) the collection names that should be read. If
+  ///              not provided (or empty) all collections will be read
+  ///
+  /// @returns FrameData for each of the entries that has been read. If fewer
+  ///          than count entries are available starting from first, only the
+  ///          available ones are returned
+  ///
+  /// @throws std::invalid_argument in case collsToRead contains collection
+  /// names that are not available
+  std::vector<std::unique_ptr<podio::ROOTFrameData>> readEntries(const std::string& name, const unsigned first,
+                                                                 const unsigned count,
+                                                                 const std::vector<std::string>& collsToRead = {});
+
   /// Get the number of entries for the given name
   ///
   /// @param name The name of the category
@@ -112,6 +150,38 @@ public:
   /// @returns The number of entries that are available for the category
   unsigned getEntries(const std::string& name) const;
 
+  /// Get the collection size index of an entry, i.e. the value type, the number
+  /// of elements and the size of the buffers of all collections, without
+  /// reading any collection data
+  ///
+  /// @param name  The category name
+  /// @param entry The entry number
+  ///
+  /// @returns The collection size index if the category and the entry exist and
+  ///          if the file has been written with a collection size index.
+  ///          Otherwise an empty optional
+  std::optional<podio::CollectionSizeIndex> getCollectionSizes(const std::string& name, const unsigned entry);
+
+  /// Enable reading entries ahead on a background thread.
+  ///
+  /// Once enabled, every category that is read via readNextEntry gets a
+  /// background thread that reads up to depth entries ahead of the current
+  /// one, while the consumer is busy with the current entry. Jumping to a
+  /// specific entry with readEntry discards the entries that have been read
+  /// ahead for that category, as does changing the collections to read.
+  ///
+  /// @note This enables ROOT's thread safety (ROOT::EnableThreadSafety), since
+  /// the data is read on a different thread than the one using the reader.
+  ///
+  /// @param depth The maximum number of entries to read ahead per category. 0
+  ///              disables prefetching again
+  void enablePrefetch(size_t depth);
+
+  /// Get the statistics of the entries that have been read ahead
+  ///
+  /// @returns The statistics. All values are 0 if prefetching is not enabled
+  ROOTReaderPrefetchStatistics getPrefetchStatistics() const;
+
   /// Get the build version of podio that has been used to write the current
   /// file
   ///
@@ -167,7 +237,11 @@ private:
     std::vector<detail::NamedCollInfo> storedClasses{};     ///< The stored collections in this
                                                             ///< category
     std::vector<root_utils::CollectionBranches> branches{}; ///< The branches for this category
-    std::shared_ptr<CollectionIDTable> table{nullptr};      ///< The collection ID table for this category
+    std::shared_ptr<const CollectionIDTable> table{nullptr}; ///< The collection ID table for this category
+    std::vector<std::string> valueTypes{}; ///< The value types of the stored collections (if available)
+    TBranch* collElementsBranch{nullptr}; ///< The branch with the number of elements of all collections
+    TBranch* collBytesBranch{nullptr};    ///< The branch with the buffer sizes of all collections
+    bool branchesStale{false}; ///< Whether the branches have to be reloaded before reading the next entry
   };
 
   /// Initialize the passed CategoryInfo by setting up the necessary branches,
@@ -193,16 +267,45 @@ private:
   std::unique_ptr<podio::ROOTFrameData> readEntry(ROOTReader::CategoryInfo& catInfo,
                                                   const std::vector<std::string>& collsToRead);
 
+  /// Read the data entry with the given number in the passed CategoryInfo
+  /// without changing the entry counter. In case the requested entry is
+  /// larger than the available number of entries, return a nullptr.
+  std::unique_ptr<podio::ROOTFrameData> readEntryData(ROOTReader::CategoryInfo& catInfo, unsigned entry,
+                                                      const std::vector<std::string>& collsToRead);
+
+  /// Read the next entry for the given category from the prefetch queue,
+  /// starting the read ahead if it is not yet running for this category
+  std::unique_ptr<podio::ROOTFrameData> readNextPrefetchedEntry(const std::string& name,
+                                                                const std::vector<std::string>& collsToRead);
+
+  /// Read the collection size index for the collections that should be read.
+  /// Returns an empty index for files without collection size index
+  podio::CollectionSizeIndex readCollectionSizes(CategoryInfo& catInfo, bool reloadBranches, unsigned int localEntry,
+                                                 const std::vector<std::string>& collsToRead);
+
   /// Get / read the buffers at index iColl in the passed category information
   podio::CollectionReadBuffers getCollectionBuffers(CategoryInfo& catInfo, size_t iColl, bool reloadBranches,
                                                     unsigned int localEntry);
 
+  /// Set up the TTreeCache of the category such that it prefetches the
+  /// branches of the passed collections (and the parameters and sizes) for the
+  /// entries in [first, last)
+  void setupCacheForRange(CategoryInfo& catInfo, const std::vector<size_t>& collIndices, Long64_t first,
+                          Long64_t last);
+
+  /// Reset the TTreeCache of the category after setupCacheForRange, such that
+  /// it covers all entries and learns the branches to cache again
+  void restoreCache(CategoryInfo& catInfo);
+
   std::unique_ptr<TChain> m_metaChain{nullptr};                 ///< The metadata tree
   std::unordered_map<std::string, CategoryInfo> m_categories{}; ///< All categories
   std::vector<std::string> m_availCategories{};                 ///< All available categories from this file
 
   podio::version::Version m_fileVersion{0, 0, 0};
   DatamodelDefinitionHolder m_datamodelHolder{};
+
+  struct Prefetcher;
+  std::unique_ptr<Prefetcher> m_prefetcher{nullptr}; ///< The read ahead machinery if prefetching is enabled
 };
 
 } // namespace podio
@@ -2,11 +2,13 @@
 #define PODIO_ROOTWRITER_H
 
 #include "podio/CollectionIDTable.h"
+#include "podio/WriterOptions.h"
 #include "podio/utilities/DatamodelRegistryIOHelpers.h"
 #include "podio/utilities/RootHelpers.h"
 
 #include "TFile.h"
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -35,7 +37,8 @@ public:
   /// @note Existing files will be overwritten without warning.
   ///
   /// @param filename The path to the file that will be created.
-  ROOTWriter(const std::string& filename);
+  /// @param options  The options for writing, e.g. the compression settings
+  ROOTWriter(const std::string& filename, const WriterOptions& options = {});
 
   /// ROOTWriter destructor
   ///
@@ -106,31 +109,42 @@ private:
     TTree* tree{nullptr};                                     ///< The TTree to which this category is written
     std::vector<root_utils::CollectionBranches> branches{};   ///< The branches for this category
     std::vector<root_utils::CollectionWriteInfoT> collInfo{}; ///< Collection info for this category
+    std::vector<std::string> valueTypes{};                    ///< The value types of all collections
     podio::CollectionIDTable idTable{};                       ///< The collection id table for this category
     std::vector<std::string> collsToWrite{};                  ///< The collections to write for this category
 
-    // Storage for the keys & values of all the parameters of this category
-    // (resp. at least the current entry)
+    // The keys & values of all the parameters of the current entry of this
+    // category. These are bound to the GenericParameters of the Frame
     root_utils::ParamStorage<int> intParams{};
     root_utils::ParamStorage<float> floatParams{};
     root_utils::ParamStorage<double> doubleParams{};
     root_utils::ParamStorage<std::string> stringParams{};
+
+    // The number of elements and the size of the buffers of each collection of
+    // the current entry of this category
+    std::vector<uint64_t> collElements{};
+    std::vector<uint64_t> collBytes{};
   };
 
   /// Initialize the branches for this category
   void initBranches(CategoryInfo& catInfo, const std::vector<root_utils::StoreCollection>& collections,
-                    /*const*/ podio::GenericParameters& parameters);
+                    const podio::GenericParameters::LockedView& parameters);
 
   /// Get the (potentially uninitialized category information for this category)
   CategoryInfo& getCategoryInfo(const std::string& category);
 
   static void resetBranches(CategoryInfo& categoryInfo, const std::vector<root_utils::StoreCollection>& collections);
 
-  /// Fill the parameter keys and values into the CategoryInfo storage
-  static void fillParams(CategoryInfo& catInfo, const GenericParameters& params);
+  /// Bind the parameter keys and values to the CategoryInfo storage
+  static void fillParams(CategoryInfo& catInfo, const GenericParameters::LockedView& params);
+
+  /// Fill the collection size index of the current entry into the CategoryInfo
+  /// storage
+  static void fillCollectionSizes(CategoryInfo& catInfo, const std::vector<root_utils::StoreCollection>& collections);
 
   std::unique_ptr<TFile> m_file{nullptr};                       ///< The storage file
   std::unordered_map<std::string, CategoryInfo> m_categories{}; ///< All categories
+  WriterOptions m_options{};                                    ///< The options for writing
 
   DatamodelDefinitionCollector m_datamodelCollector{};
 
@@ -25,6 +25,7 @@ private:
     virtual podio::Frame readNextFrame(const std::string& name, const std::vector<std::string>&) = 0;
     virtual podio::Frame readFrame(const std::string& name, size_t index, const std::vector<std::string>&) = 0;
     virtual size_t getEntries(const std::string& name) const = 0;
+    virtual std::optional<podio::CollectionSizeIndex> getCollectionSizes(const std::string& name, size_t index) = 0;
     virtual podio::version::Version currentFileVersion() const = 0;
     virtual std::optional<podio::version::Version> currentFileVersion(const std::string& name) const = 0;
     virtual std::vector<std::string_view> getAvailableCategories() const = 0;
@@ -64,6 +65,15 @@ private:
     size_t getEntries(const std::string& name) const override {
       return m_reader->getEntries(name);
     }
+
+    std::optional<podio::CollectionSizeIndex> getCollectionSizes(const std::string& name, size_t index) override {
+      if constexpr (requires { m_reader->getCollectionSizes(name, index); }) {
+        return m_reader->getCollectionSizes(name, index);
+      } else {
+        return std::nullopt;
+      }
+    }
+
     podio::version::Version currentFileVersion() const override {
       return m_reader->currentFileVersion();
     }
@@ -166,6 +176,20 @@ public:
     return m_self->getEntries(name);
   }
 
+  /// Get the collection size index of an entry, i.e. the value type, the number
+  /// of elements and the size of the buffers of all collections, without
+  /// reading any collection data
+  ///
+  /// @param name  The name of the category
+  /// @param index The entry number
+  ///
+  /// @returns The collection size index if the entry exists and the file has
+  ///          been written with a collection size index. Otherwise an empty
+  ///          optional
+  std::optional<podio::CollectionSizeIndex> getCollectionSizes(const std::string& name, size_t index) {
+    return m_self->getCollectionSizes(name, index);
+  }
+
   /// Get the number of events
   ///
   /// @returns The number of entries that are available for the category
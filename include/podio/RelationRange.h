@@ -7,15 +7,20 @@
 namespace podio {
 /// A simple helper class that allows one to return related objects in a way that
 /// makes it possible to use the return type in a range-based for loop.
-template <typename ReferenceType>
+///
+/// The iterators usually point into a vector of handles, but can also be
+/// iterators that create the handles on the fly. These only have to model
+/// std::random_access_iterator for size and indexed access to be cheap, since
+/// the std::ranges functions are used for them.
+template <typename ReferenceType, typename IteratorType = typename std::vector<ReferenceType>::const_iterator>
 class RelationRange {
 public:
-  using ConstIteratorType = typename std::vector<ReferenceType>::const_iterator;
+  using ConstIteratorType = IteratorType;
 
   RelationRange() = delete;
 
   RelationRange(ConstIteratorType begin, ConstIteratorType end) :
-      m_begin(begin), m_end(end), m_size(std::distance(m_begin, m_end)) {
+      m_begin(begin), m_end(end), m_size(std::ranges::distance(m_begin, m_end)) {
   }
 
   /// begin of the range (necessary for range-based for loop)
@@ -36,16 +41,12 @@ public:
   }
   /// Indexed access
   ReferenceType operator[](size_t i) const {
-    auto it = m_begin;
-    std::advance(it, i);
-    return *it;
+    return *std::ranges::next(m_begin, i);
   }
   /// Indexed access with range check
   ReferenceType at(size_t i) const {
     if (i < m_size) {
-      auto it = m_begin;
-      std::advance(it, i);
-      return *it;
+      return *std::ranges::next(m_begin, i);
     }
     throw std::out_of_range("index out of bounds for RelationRange");
   }
@@ -58,10 +59,10 @@ private:
 } // namespace podio
 
 // Opt-in to view concept
-template <typename ReferenceType>
-inline constexpr bool std::ranges::enable_view<podio::RelationRange<ReferenceType>> = true;
+template <typename ReferenceType, typename IteratorType>
+inline constexpr bool std::ranges::enable_view<podio::RelationRange<ReferenceType, IteratorType>> = true;
 // Opt-in to borrowed_range concept
-template <typename ReferenceType>
-inline constexpr bool std::ranges::enable_borrowed_range<podio::RelationRange<ReferenceType>> = true;
+template <typename ReferenceType, typename IteratorType>
+inline constexpr bool std::ranges::enable_borrowed_range<podio::RelationRange<ReferenceType, IteratorType>> = true;
 
 #endif // PODIO_RELATIONRANGE_H
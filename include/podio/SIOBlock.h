@@ -8,6 +8,8 @@
 #include <podio/utilities/TypeHelpers.h>
 
 #include <sio/block.h>
+#include <sio/buffer.h>
+#include <sio/definitions.h>
 #include <sio/io_device.h>
 #include <sio/version.h>
 
@@ -137,6 +139,70 @@ private:
   std::vector<short> _isSubsetColl{};
 };
 
+/// The index of the separately compressed blocks of a Frame data record. It is
+/// stored in the table record of the Frame, such that single blocks can be
+/// located and decompressed without touching the other ones. Data records
+/// without such an index have been compressed as a whole.
+///
+/// Since version 0.2 the blocks can also be stored without compression (for a
+/// compression level of 0), in which case they are read directly from the
+/// data record.
+struct SIOCompressedBlockIndexBlock : public sio::block {
+  SIOCompressedBlockIndexBlock() : sio::block("CompressedBlockIndex", sio::version::encode_version(0, 2)) {
+  }
+
+  SIOCompressedBlockIndexBlock(const SIOCompressedBlockIndexBlock&) = delete;
+  SIOCompressedBlockIndexBlock& operator=(const SIOCompressedBlockIndexBlock&) = delete;
+
+  void read(sio::read_device& device, sio::version_type version) override;
+  void write(sio::write_device& device) override;
+
+  /// Add a block that starts at offset in the compressed data
+  void addBlock(uint64_t offset, uint32_t compressedSize, uint32_t uncompressedSize) {
+    offsets.push_back(offset);
+    compressedSizes.push_back(compressedSize);
+    uncompressedSizes.push_back(uncompressedSize);
+  }
+
+  std::vector<uint64_t> offsets{};           ///< The start of each block in the compressed data
+  std::vector<uint32_t> compressedSizes{};   ///< The compressed size of each block
+  std::vector<uint32_t> uncompressedSizes{}; ///< The uncompressed size of each block
+  short compressed{1}; ///< Whether the blocks are compressed. Always the case before version 0.2
+};
+
+/// The number of elements and the size of the buffers of all collections of a
+/// Frame, in the same order as in the SIOCollectionIDTableBlock. It is stored in
+/// the table record of the Frame, such that the sizes are available without
+/// touching the data record. Older files do not have this block.
+struct SIOCollectionSizeIndexBlock : public sio::block {
+  SIOCollectionSizeIndexBlock() : sio::block("CollectionSizeIndex", sio::version::encode_version(0, 1)) {
+  }
+
+  SIOCollectionSizeIndexBlock(const SIOCollectionSizeIndexBlock&) = delete;
+  SIOCollectionSizeIndexBlock& operator=(const SIOCollectionSizeIndexBlock&) = delete;
+
+  void read(sio::read_device& device, sio::version_type version) override;
+  void write(sio::write_device& device) override;
+
+  std::vector<uint64_t> elements{}; ///< The number of elements of each collection
+  std::vector<uint64_t> bytes{};    ///< The size of the buffers of each collection
+};
+
+/// The block holding all separately compressed blocks of a Frame data record,
+/// see SIOCompressedBlockIndexBlock
+struct SIOCompressedBlocksBlock : public sio::block {
+  SIOCompressedBlocksBlock() : sio::block("CompressedBlocks", sio::version::encode_version(0, 1)) {
+  }
+
+  SIOCompressedBlocksBlock(const SIOCompressedBlocksBlock&) = delete;
+  SIOCompressedBlocksBlock& operator=(const SIOCompressedBlocksBlock&) = delete;
+
+  void read(sio::read_device& device, sio::version_type version) override;
+  void write(sio::write_device& device) override;
+
+  sio::buffer::container data{}; ///< The concatenated compressed blocks
+};
+
 struct SIOVersionBlock : public sio::block {
   SIOVersionBlock() : sio::block("podio_version", sio::version::encode_version(1, 0)) {
   }
@@ -283,17 +349,25 @@ public:
 namespace sio_helpers {
   /// marker for showing that a TOC has been stored in the file
   static constexpr uint32_t SIOTocMarker = 0xc001fea7;
+  /// marker for showing that a TOC has been stored in the file and that its
+  /// start position is stored as a full 64 bit word in front of the marker
+  static constexpr uint32_t SIOTocMarker64 = 0xc001fea8;
   /// the number of bits necessary to store the SIOTocMarker and the actual
   /// position of the start of the SIOFileTOCRecord
   static constexpr int SIOTocInfoSize = sizeof(uint64_t); // i.e. usually 8
+  /// the number of bytes necessary to store the SIOTocMarker64 and the 64 bit
+  /// position of the start of the SIOFileTOCRecord
+  static constexpr int SIOTocInfoSize64 = 2 * sizeof(uint64_t);
   /// The name of the TOCRecord
   static constexpr const char* SIOTocRecordName = "podio_SIO_TOC_Record";
 
   /// The name of the record containing the EDM definitions in json format
   static constexpr const char* SIOEDMDefinitionName = "podio_SIO_EDMDefinitions";
 
-  // should hopefully be enough for all practical purposes
-  using position_type = uint32_t;
+  /// Positions are stored with 64 bits to support files larger than 4 GiB.
+  /// Files that are smaller are still written with 32 bit positions to keep
+  /// them readable by older versions
+  using position_type = uint64_t;
 } // namespace sio_helpers
 
 class SIOFileTOCRecord {
@@ -321,12 +395,14 @@ private:
   MapType m_recordMap{};
 };
 
+/// The block for storing the SIOFileTOCRecord. Version 0.1 stores 32 bit
+/// positions, version 0.2 stores 64 bit positions. Reading handles both
 struct SIOFileTOCRecordBlock : public sio::block {
-  SIOFileTOCRecordBlock() : sio::block(sio_helpers::SIOTocRecordName, sio::version::encode_version(0, 1)) {
+  SIOFileTOCRecordBlock() : sio::block(sio_helpers::SIOTocRecordName, sio::version::encode_version(0, 2)) {
   }
 
-  SIOFileTOCRecordBlock(SIOFileTOCRecord* r) :
-      sio::block(sio_helpers::SIOTocRecordName, sio::version::encode_version(0, 1)), record(r) {
+  SIOFileTOCRecordBlock(SIOFileTOCRecord* r, bool largePositions = true) :
+      sio::block(sio_helpers::SIOTocRecordName, sio::version::encode_version(0, largePositions ? 2 : 1)), record(r) {
   }
 
   SIOFileTOCRecordBlock(const SIOFileTOCRecordBlock&) = delete;
@@ -338,5 +414,19 @@ struct SIOFileTOCRecordBlock : public sio::block {
   SIOFileTOCRecord* record{nullptr};
 };
 
+namespace sio_helpers {
+  /// Write the SIOFileTOCRecord at the current position of the stream followed
+  /// by the marker that points to it. If the record starts beyond 4 GiB, 64 bit
+  /// positions are used, otherwise the layout that older versions can read.
+  void writeFileTOCRecord(sio::ofstream& stream, SIOFileTOCRecord& tocRecord);
+
+  /// Read the SIOFileTOCRecord of a file via the marker at its end. Both the
+  /// 32 and the 64 bit layouts are supported. Afterwards the stream is
+  /// positioned at the start of the file again.
+  ///
+  /// @returns true if a TOC record has been found and read, false otherwise
+  bool readFileTOCRecord(sio::ifstream& stream, SIOFileTOCRecord& tocRecord);
+} // namespace sio_helpers
+
 } // namespace podio
 #endif
@@ -3,11 +3,14 @@
 
 #include "podio/CollectionBuffers.h"
 #include "podio/CollectionIDTable.h"
+#include "podio/CollectionSizeIndex.h"
 #include "podio/GenericParameters.h"
 
 #include <sio/buffer.h>
 #include <sio/definitions.h>
 
+#include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -16,6 +19,12 @@ namespace podio {
 /// The Frame data container for the SIO backend. It is constructed from the
 /// compressed sio::buffers that is read from file and does all the necessary
 /// unpacking and decompressing internally after construction.
+///
+/// If the blocks of the data record have been compressed separately only the
+/// blocks that are actually requested are decompressed. Blocks that have been
+/// stored without compression are deserialized directly from the data record,
+/// i.e. without any intermediate buffer. Otherwise the whole data record is
+/// decompressed on first access.
 class SIOFrameData {
 
 public:
@@ -38,32 +47,72 @@ public:
   SIOFrameData(sio::buffer&& collBuffers, std::size_t dataSize, sio::buffer&& tableBuffer, std::size_t tableSize,
                std::vector<std::string> limitColls = {});
 
+  /// Constructor from the data and table records as they have been read from
+  /// file, where the record infos determine how much the records occupy in
+  /// the buffers.
+  ///
+  /// In case the limitColls contain a collection name that is not available
+  /// from the idTable names this throws an exception
+  SIOFrameData(sio::buffer&& collBuffers, const sio::record_info& dataInfo, sio::buffer&& tableBuffer,
+               const sio::record_info& tableInfo, std::vector<std::string> limitColls = {});
+
+  /// Constructor from data and table records that reside in memory that is
+  /// owned by somebody else, e.g. a memory mapped file. The records are
+  /// decompressed (or for uncompressed blocks deserialized) from there and the
+  /// owner is kept alive as long as necessary.
+  ///
+  /// In case the limitColls contain a collection name that is not available
+  /// from the idTable names this throws an exception
+  SIOFrameData(sio::buffer_span dataRecord, const sio::record_info& dataInfo, sio::buffer_span tableRecord,
+               const sio::record_info& tableInfo, std::shared_ptr<const void> owner,
+               std::vector<std::string> limitColls = {});
+
   std::optional<podio::CollectionReadBuffers> getCollectionBuffers(const std::string& name);
 
   podio::CollectionIDTable getIDTable() {
-    return {m_idTable.ids(), m_idTable.names()};
+    return m_idTable.copy();
   }
 
   std::unique_ptr<podio::GenericParameters> getParameters();
 
   std::vector<std::string> getAvailableCollections();
 
+  const podio::CollectionSizeIndex& getCollectionSizes() const {
+    return m_collSizes;
+  }
+
 private:
   void unpackBuffers();
 
-  void readIdTable();
+  /// Decompress and read the block with the given index (if it has not yet
+  /// been read). Only necessary for separately compressed (or stored) blocks
+  void unpackBlock(size_t index);
+
+  /// Point the record data directly to the blocks that have been stored
+  /// without compression. Returns false if they cannot be located, in which
+  /// case they have to be read from the SIOCompressedBlocksBlock
+  bool locateStoredBlocks();
+
+  void readIdTable(const sio::buffer_span& table);
+
+  /// Check that all the collections that should be read are available
+  void checkLimitColls() const;
 
   void createBlocks();
 
   // Default initialization doesn't really matter here, because they are made
   // the correct size on construction
-  sio::buffer m_recBuffer{sio::kbyte};   ///< The compressed record (data) buffer
+  sio::buffer m_recBuffer{sio::kbyte};   ///< The record (data) buffer or the compressed blocks
   sio::buffer m_tableBuffer{sio::kbyte}; ///< The compressed collection id table buffer
 
+  sio::buffer_span m_recData{};          ///< The data that is used, either from the buffer or from the owner
+  std::shared_ptr<const void> m_owner{}; ///< The owner of the data if it is not in the buffer
+
   std::size_t m_dataSize{};  ///< Uncompressed data buffer size
   std::size_t m_tableSize{}; ///< Uncompressed table size
 
   std::vector<short> m_availableBlocks{}; ///< The blocks that have already been retrieved
+  std::vector<short> m_unpackedBlocks{};  ///< The blocks that have already been decompressed and read
 
   sio::block_list m_blocks{};
 
@@ -71,8 +120,19 @@ private:
   std::vector<std::string> m_typeNames{};
   std::vector<short> m_subsetCollectionBits{};
 
+  /// The index of the separately compressed blocks. Empty if the data record
+  /// has been compressed as a whole
+  std::vector<uint64_t> m_blockOffsets{};
+  std::vector<uint32_t> m_blockSizes{};             ///< The compressed sizes of the blocks
+  std::vector<uint32_t> m_blockUncompressedSizes{}; ///< The uncompressed sizes of the blocks
+  bool m_blocksCompressed{true};                    ///< Whether the separate blocks are compressed or stored
+
   podio::GenericParameters m_parameters{};
 
+  /// The number of elements and buffer sizes of the collections that are
+  /// available. Empty for files without collection size index
+  podio::CollectionSizeIndex m_collSizes{};
+
   /// The collections that should be made available for a Frame constructed from
   /// this (if non-empty)
   std::vector<std::string> m_limitColls{};
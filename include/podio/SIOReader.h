@@ -9,19 +9,32 @@
 #include <sio/definitions.h>
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace podio {
 
 class CollectionIDTable;
 
+namespace sio_utils {
+  class MappedFile;
+}
+
 /// The SIOReader can be used to read files that have been written with the SIO
 /// backend.
 ///
 /// The SIOReader provides the data as SIOFrameData from which a podio::Frame
 /// can be constructed. It can be used to read files written by the SIOWriter.
+/// Several files can be read as if they were one, in which case the entries
+/// are numbered globally in the order in which the files have been passed.
+///
+/// Optionally the files can be memory mapped (see enableMemoryMap), in which
+/// case the records are decompressed (or deserialized) directly from the
+/// mapping instead of being read into intermediate buffers first.
 class SIOReader {
 
 public:
@@ -38,10 +51,10 @@ public:
   /// Read the next data entry for a given category.
   ///
   /// @note Given how the SIO files are currently layed out it is in fact not
-  /// possible to only read a subset of a Frame. Rather the subset of
-  /// collections to read will be an artificial limit on the returned
-  /// SIOFrameData. Limiting the collections to read will not improve I/O
-  /// performance.
+  /// possible to only read a subset of a Frame from file. For files in which
+  /// the collections are compressed separately only the requested collections
+  /// are decompressed, for older files the subset of collections to read is
+  /// only an artificial limit on the returned SIOFrameData.
   ///
   /// @param name The category name for which to read the next entry
   /// @param collsToRead (optional) the collection names that should be read. If
@@ -56,10 +69,10 @@ public:
   /// Read the desired data entry for a given category.
   ///
   /// @note Given how the SIO files are currently layed out it is in fact not
-  /// possible to only read a subset of a Frame. Rather the subset of
-  /// collections to read will be an artificial limit on the returned
-  /// SIOFrameData. Limiting the collections to read will not improve I/O
-  /// performance.
+  /// possible to only read a subset of a Frame from file. For files in which
+  /// the collections are compressed separately only the requested collections
+  /// are decompressed, for older files the subset of collections to read is
+  /// only an artificial limit on the returned SIOFrameData.
   ///
   /// @param name  The category name for which to read the next entry
   /// @param entry The entry number to read
@@ -71,20 +84,84 @@ public:
   std::unique_ptr<podio::SIOFrameData> readEntry(const std::string& name, const unsigned entry,
                                                  const std::vector<std::string>& collsToRead = {});
 
+  /// Read several consecutive entries for a given category in one go.
+  ///
+  /// The entries are distributed over the threads of the process wide
+  /// podio::utils::sharedThreadPool with nThreads threads, each of which reads
+  /// its share of the entries via its own file streams, such that entries from
+  /// different files (or different offsets in the same file) are read
+  /// concurrently. These streams are kept open for later calls. The records are read without decompressing them, that
+  /// happens when the Frames are constructed. Afterwards readNextEntry
+  /// continues after the last entry that has been read.
+  ///
+  /// @param name  The category name for which to read the entries
+  /// @param first The first entry number to read
+  /// @param count The number of entries to read
+  /// @param collsToRead (optional) the collection names that should be read. If
+  ///             not provided (or empty) all collections will be read
+  /// @param nThreads (optional) the number of threads of the pool to use. 0
+  ///             uses the available hardware concurrency
+  ///
+  /// @returns FrameData for all the requested entries that are available, in
+  ///          entry order. This can be fewer than requested if the category
+  ///          does not have enough entries
+  std::vector<std::unique_ptr<podio::SIOFrameData>> readEntries(const std::string& name, const unsigned first,
+                                                                const unsigned count,
+                                                                const std::vector<std::string>& collsToRead = {},
+                                                                const unsigned nThreads = 0);
+
+  /// Read the records directly from a read-only memory mapping of the files
+  /// instead of reading them via file streams.
+  ///
+  /// This avoids reading the records into intermediate buffers, they are
+  /// decompressed directly from the mapping. Records that have been written
+  /// with a compression level of 0 are deserialized directly from the mapping,
+  /// i.e. the data of each collection are copied exactly once, from the
+  /// mapping into its buffers. The mapping is kept alive as long as any
+  /// SIOFrameData that has been read from it. Can be called before or after
+  /// the files have been opened.
+  ///
+  /// @param enable Whether to enable or disable the memory mapped mode
+  void enableMemoryMap(bool enable = true);
+
   /// Get the number of entries for the given name
   ///
   /// @param name The name of the category
   ///
-  /// @returns The number of entries that are available for the category
+  /// @returns The number of entries that are available for the category in
+  ///          all opened files
   unsigned getEntries(const std::string& name) const;
 
+  /// Get the collection size index of an entry, i.e. the value type, the number
+  /// of elements and the size of the buffers of all collections, without
+  /// reading any collection data
+  ///
+  /// @note Only the (small) table record of the entry is read for this
+  ///
+  /// @param name  The category name
+  /// @param entry The entry number
+  ///
+  /// @returns The collection size index if the category and the entry exist and
+  ///          if the file has been written with a collection size index.
+  ///          Otherwise an empty optional
+  std::optional<podio::CollectionSizeIndex> getCollectionSizes(const std::string& name, const unsigned entry);
+
   /// Open the passed file for reading.
   ///
   /// @param filename The path to the file to read from
   void openFile(const std::string& filename);
 
+  /// Open the passed files for reading.
+  ///
+  /// The entries of all files are available via one global entry index, in
+  /// the order in which the files are passed. The datamodel definitions are
+  /// taken from the first file.
+  ///
+  /// @param filenames The paths to the files to read from
+  void openFiles(const std::vector<std::string>& filenames);
+
   /// Get the build version of podio that has been used to write the current
-  /// file
+  /// file, i.e. the one from which the last entry has been read
   ///
   /// @returns The podio build version
   podio::version::Version currentFileVersion() const {
@@ -102,7 +179,7 @@ public:
     return m_datamodelHolder.getDatamodelVersion(name);
   }
 
-  /// Get the names of all the available Frame categories in the current file.
+  /// Get the names of all the available Frame categories in the first file.
   ///
   /// @returns The names of the available categores from the file
   std::vector<std::string_view> getAvailableCategories() const;
@@ -124,24 +201,38 @@ public:
   }
 
 private:
-  void readPodioHeader();
+  /// Everything that is necessary for reading from one file
+  struct FileInfo {
+    std::string filename{};                 ///< The name of the file
+    sio::ifstream stream{};                 ///< The stream from which we read
+    SIOFileTOCRecord toc{};                 ///< Table of content with the starting points of all records
+    podio::version::Version fileVersion{0}; ///< The podio version that has been used to write the file
+    /// The memory mapping of the file (if enabled)
+    std::shared_ptr<const sio_utils::MappedFile> mapping{};
+    /// Additional streams for reading entries concurrently in readEntries, one
+    /// per additional thread. They are opened on first use and kept open
+    std::vector<sio::ifstream> chunkStreams{};
+  };
 
-  /// read the TOC record
-  bool readFileTOCRecord();
+  void readPodioHeader(FileInfo& file);
 
-  void readEDMDefinitions();
+  void readEDMDefinitions(FileInfo& file);
 
-  sio::ifstream m_stream{}; ///< The stream from which we read
+  /// Find the file index and the entry in that file for the (global) entry of
+  /// a given category. Returns an empty optional if the entry does not exist
+  std::optional<std::pair<size_t, unsigned>> locateEntry(const std::string& name, unsigned entry) const;
+
+  std::vector<std::unique_ptr<FileInfo>> m_files{}; ///< All opened files
 
   /// Count how many times each an entry of this name has been read already
   std::unordered_map<std::string, unsigned> m_nameCtr{};
 
-  /// Table of content record where starting points of named entries can be read from
-  SIOFileTOCRecord m_tocRecord{};
-  /// The podio version that has been used to write the file
+  /// The podio version that has been used to write the current file
   podio::version::Version m_fileVersion{0};
 
   DatamodelDefinitionHolder m_datamodelHolder{};
+
+  bool m_useMemoryMap{false}; ///< Whether the files should be memory mapped
 };
 
 } // namespace podio
@@ -2,10 +2,15 @@
 #define PODIO_SIOWRITER_H
 
 #include "podio/SIOBlock.h"
+#include "podio/WriterOptions.h"
 #include "podio/utilities/DatamodelRegistryIOHelpers.h"
+#include "podio/utilities/ThreadPool.h"
 
+#include <sio/buffer.h>
 #include <sio/definitions.h>
 
+#include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -14,6 +19,14 @@ namespace podio {
 
 class Frame;
 
+/// An SIO record that has been written (and potentially compressed) into
+/// memory, but that has not yet been written to file
+struct SIOEncodedRecord {
+  sio::record_info info{};                             ///< The record info
+  sio::buffer buffer;                                  ///< The record header and the uncompressed data
+  std::optional<sio::buffer> compressed{std::nullopt}; ///< The compressed data (if the record is compressed)
+};
+
 /// The SIOWriter writes podio files into SIO files.
 ///
 /// Each Frame is stored into an SIO record which are written in the order in
@@ -29,7 +42,12 @@ public:
   /// @note Existing files will be overwritten without warning.
   ///
   /// @param filename The path to the file that will be created.
-  SIOWriter(const std::string& filename);
+  /// @param options  The options for writing, e.g. the compression settings.
+  ///                 Only zlib compression is supported by SIO
+  ///
+  /// @throws std::invalid_argument if a compression codec other than zlib is
+  /// requested
+  SIOWriter(const std::string& filename, const WriterOptions& options = {});
 
   /// SIOWriter destructor
   ///
@@ -63,6 +81,36 @@ public:
   /// @param collsToWrite The collection names that should be written
   void writeFrame(const podio::Frame& frame, const std::string& category, const std::vector<std::string>& collsToWrite);
 
+  /// A Frame that has been encoded into SIO records, but that has not yet been
+  /// written to file
+  struct EncodedFrame {
+    std::string category;                              ///< The category of the Frame
+    SIOEncodedRecord table;                            ///< The record with the collection ID table
+    SIOEncodedRecord data;                             ///< The record with the collections and parameters
+    DatamodelDefinitionCollector datamodelCollector{}; ///< The datamodels of the encoded collections
+  };
+
+  /// Encode the desired collections of the given Frame into SIO records,
+  /// without writing them to file.
+  ///
+  /// This does the serialization and compression of the Frame and can be
+  /// called concurrently from several threads. writeFrame is equivalent to
+  /// passing the result of this to writeEncodedFrame.
+  ///
+  /// @param frame        The Frame to encode
+  /// @param category     The category name under which this Frame should be
+  ///                     stored
+  /// @param collsToWrite The collection names that should be written
+  ///
+  /// @returns The encoded Frame that can be written via writeEncodedFrame
+  EncodedFrame encodeFrame(const podio::Frame& frame, const std::string& category,
+                           const std::vector<std::string>& collsToWrite) const;
+
+  /// Write a Frame that has previously been encoded via encodeFrame
+  ///
+  /// @param frame The encoded Frame
+  void writeEncodedFrame(EncodedFrame&& frame);
+
   /// Write the current file, including all the necessary metadata to read it
   /// again.
   ///
@@ -73,8 +121,12 @@ public:
 private:
   sio::ofstream m_stream{};       ///< The output file stream
   SIOFileTOCRecord m_tocRecord{}; ///< The "table of contents" of the written file
+  WriterOptions m_options{};      ///< The options for writing
   DatamodelDefinitionCollector m_datamodelCollector{};
   bool m_finished{false}; ///< Has finish been called already?
+  /// The threads for compressing the blocks of a Frame (if more than one
+  /// thread should be used)
+  std::unique_ptr<utils::ThreadPool> m_compressionPool{nullptr};
 };
 } // namespace podio
 
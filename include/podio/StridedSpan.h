@@ -0,0 +1,194 @@
+#ifndef PODIO_STRIDEDSPAN_H
+#define PODIO_STRIDEDSPAN_H
+
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+namespace podio {
+
+/// A non-owning view of elements that are placed in memory with a constant
+/// distance between them, e.g. one member of all elements of an array of
+/// structs.
+///
+/// This makes it possible to access one member of all elements of a collection
+/// without copying anything. The data pointer, the size and the stride (in
+/// bytes) are exposed such that the data can be handed to other libraries
+/// (e.g. numpy) that support strided arrays.
+///
+/// @tparam T The type of the elements
+template <typename T>
+class StridedSpan {
+  using BytePtr = std::conditional_t<std::is_const_v<T>, const std::byte*, std::byte*>;
+
+public:
+  using element_type = T;
+  using value_type = std::remove_cv_t<T>;
+  using size_type = std::size_t;
+
+  /// Random access iterator over the elements of a StridedSpan
+  class Iterator {
+  public:
+    using value_type = std::remove_cv_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using pointer = T*;
+    using iterator_category = std::random_access_iterator_tag;
+    using iterator_concept = std::random_access_iterator_tag;
+
+    Iterator() = default;
+    Iterator(BytePtr ptr, std::size_t stride) : m_ptr(ptr), m_stride(stride) {
+    }
+
+    bool operator==(const Iterator& other) const {
+      return m_ptr == other.m_ptr;
+    }
+
+    std::strong_ordering operator<=>(const Iterator& other) const {
+      return m_ptr <=> other.m_ptr;
+    }
+
+    reference operator*() const {
+      return *reinterpret_cast<T*>(m_ptr);
+    }
+
+    pointer operator->() const {
+      return reinterpret_cast<T*>(m_ptr);
+    }
+
+    reference operator[](difference_type n) const {
+      return *(*this + n);
+    }
+
+    Iterator& operator++() {
+      m_ptr += m_stride;
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      auto copy = *this;
+      m_ptr += m_stride;
+      return copy;
+    }
+
+    Iterator& operator--() {
+      m_ptr -= m_stride;
+      return *this;
+    }
+
+    Iterator operator--(int) {
+      auto copy = *this;
+      m_ptr -= m_stride;
+      return copy;
+    }
+
+    Iterator& operator+=(difference_type n) {
+      m_ptr += n * static_cast<difference_type>(m_stride);
+      return *this;
+    }
+
+    Iterator& operator-=(difference_type n) {
+      m_ptr -= n * static_cast<difference_type>(m_stride);
+      return *this;
+    }
+
+    friend Iterator operator+(Iterator it, difference_type n) {
+      return it += n;
+    }
+
+    friend Iterator operator+(difference_type n, Iterator it) {
+      return it += n;
+    }
+
+    friend Iterator operator-(Iterator it, difference_type n) {
+      return it -= n;
+    }
+
+    friend difference_type operator-(const Iterator& x, const Iterator& y) {
+      return x.m_stride == 0 ? 0 : (x.m_ptr - y.m_ptr) / static_cast<difference_type>(x.m_stride);
+    }
+
+  private:
+    BytePtr m_ptr{nullptr};
+    std::size_t m_stride{0};
+  };
+
+  using iterator = Iterator;
+
+  StridedSpan() = default;
+
+  /// Create a view of size elements, starting at first, with stride bytes
+  /// between the start of two consecutive elements
+  StridedSpan(T* first, std::size_t size, std::size_t stride) :
+      m_data(reinterpret_cast<BytePtr>(first)), m_size(size), m_stride(stride) {
+  }
+
+  /// Pointer to the first element
+  T* data() const {
+    return reinterpret_cast<T*>(m_data);
+  }
+  /// The number of elements
+  std::size_t size() const {
+    return m_size;
+  }
+  /// Check whether there are no elements
+  bool empty() const {
+    return m_size == 0;
+  }
+  /// The distance between the start of two consecutive elements in bytes
+  std::size_t stride() const {
+    return m_stride;
+  }
+
+  /// Indexed access
+  T& operator[](std::size_t i) const {
+    return *reinterpret_cast<T*>(m_data + i * m_stride);
+  }
+  /// Indexed access with range check
+  T& at(std::size_t i) const {
+    if (i < m_size) {
+      return (*this)[i];
+    }
+    throw std::out_of_range("index out of bounds for StridedSpan");
+  }
+
+  Iterator begin() const {
+    return {m_data, m_stride};
+  }
+  Iterator end() const {
+    return {m_data + m_size * m_stride, m_stride};
+  }
+
+  /// Check whether the elements are placed directly one after the other
+  bool isContiguous() const {
+    return m_stride == sizeof(T) || m_size <= 1;
+  }
+
+  /// Get a std::span of the elements, if they are contiguous (see isContiguous)
+  std::span<T> asSpan() const {
+    if (!isContiguous()) {
+      throw std::logic_error("Cannot convert a StridedSpan with non-contiguous elements to a std::span");
+    }
+    return {data(), m_size};
+  }
+
+private:
+  BytePtr m_data{nullptr};
+  std::size_t m_size{0};
+  std::size_t m_stride{0};
+};
+
+} // namespace podio
+
+// Opt-in to view concept
+template <typename T>
+inline constexpr bool std::ranges::enable_view<podio::StridedSpan<T>> = true;
+// Opt-in to borrowed_range concept
+template <typename T>
+inline constexpr bool std::ranges::enable_borrowed_range<podio::StridedSpan<T>> = true;
+
+#endif // PODIO_STRIDEDSPAN_H
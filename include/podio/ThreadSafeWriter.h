@@ -0,0 +1,254 @@
+#ifndef PODIO_THREADSAFEWRITER_H
+#define PODIO_THREADSAFEWRITER_H
+
+#include "podio/Frame.h"
+#include "podio/WriterOptions.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace podio {
+
+namespace detail {
+  /// Writers that can do the serialization of a Frame separately from (and
+  /// concurrently to) writing it to file
+  template <typename T>
+  concept EncodingWriter = requires(const T& writer, T& mutWriter, const podio::Frame& frame) {
+    mutWriter.writeEncodedFrame(writer.encodeFrame(frame, std::string{}, std::vector<std::string>{}));
+  };
+} // namespace detail
+
+/// A writer that can be shared between several threads that write Frames into
+/// the same file.
+///
+/// The Frames are written to file one at a time, i.e. calls to writeFrame from
+/// different threads are serialized. Only the work that can be done for each
+/// Frame independently of the file happens in parallel on the calling threads.
+/// For all writers this is the preparation of the collections for writing. For
+/// writers that offer encodeFrame and writeEncodedFrame (e.g. the SIOWriter)
+/// this also includes the serialization and compression, for the ROOT based
+/// writers the filling of the branches or fields is not parallelized.
+///
+/// The order in which Frames end up in the file is the order in which they
+/// reach the file access. If a sequence number is passed, Frames of the same
+/// category are written in the order of their sequence numbers instead. In
+/// that case the sequence numbers of a category have to start at 0 and every
+/// number has to be used exactly once, since writeFrame waits until all Frames
+/// with smaller sequence numbers have been written (or have failed).
+class ThreadSafeWriter {
+private:
+  struct WriterConcept;
+
+  /// Exclusive access to the underlying writer for writing one Frame. Waits
+  /// until it is the turn of the passed sequence number (if any) and lets the
+  /// next Frame of the sequence through when it goes out of scope, also if
+  /// writing this Frame fails
+  class Turn {
+  public:
+    Turn(ThreadSafeWriter& writer, const std::string& category, std::optional<uint64_t> sequence);
+    ~Turn() = default;
+    Turn(const Turn&) = delete;
+    Turn& operator=(const Turn&) = delete;
+    Turn(Turn&&) = delete;
+    Turn& operator=(Turn&&) = delete;
+
+  private:
+    /// Advances the sequence of the category when it is destroyed. This is a
+    /// member (and not done in ~Turn) such that it also happens if the
+    /// constructor of the Turn throws after the wait
+    class Release {
+    public:
+      Release(ThreadSafeWriter& writer, const std::string& category, std::optional<uint64_t> sequence);
+      ~Release();
+      Release(const Release&) = delete;
+      Release& operator=(const Release&) = delete;
+      Release(Release&&) = delete;
+      Release& operator=(Release&&) = delete;
+
+    private:
+      ThreadSafeWriter& m_writer;
+      const std::string& m_category;
+      std::optional<uint64_t> m_sequence;
+    };
+
+    std::unique_lock<std::mutex> m_lock; ///< Has to be declared before m_release to be released after it
+    Release m_release;
+  };
+
+  /// Wait until it is the turn of the passed sequence number (if any) and
+  /// return the lock that gives exclusive access to the underlying writer
+  std::unique_lock<std::mutex> waitForTurn(const std::string& category, std::optional<uint64_t> sequence);
+
+  /// Let the next Frame of the sequence through without writing anything, for
+  /// Frames that failed before they could be written. Does not throw
+  void skipTurn(const std::string& category, std::optional<uint64_t> sequence) noexcept;
+
+  /// Run the preparation of a Frame for writing. If that fails the Frame still
+  /// has to take its turn, otherwise it would block all the Frames after it in
+  /// the sequence
+  template <typename F>
+  static decltype(auto) prepare(ThreadSafeWriter& self, const std::string& category, std::optional<uint64_t> sequence,
+                                F&& func) {
+    try {
+      return func();
+    } catch (...) {
+      self.skipTurn(category, sequence);
+      throw;
+    }
+  }
+
+  struct WriterConcept {
+    virtual ~WriterConcept() = default;
+    virtual void writeFrame(const podio::Frame& frame, const std::string& category,
+                            const std::vector<std::string>& collections, ThreadSafeWriter& self,
+                            std::optional<uint64_t> sequence) = 0;
+    virtual void finish() = 0;
+  };
+
+  template <typename T>
+  struct WriterModel final : WriterConcept {
+    WriterModel(std::unique_ptr<T> writer) : m_writer(std::move(writer)) {
+    }
+    WriterModel(const WriterModel&) = delete;
+    WriterModel& operator=(const WriterModel&) = delete;
+    WriterModel(WriterModel&&) = default;
+    WriterModel& operator=(WriterModel&&) = default;
+
+    ~WriterModel() = default;
+
+    void writeFrame(const podio::Frame& frame, const std::string& category,
+                    const std::vector<std::string>& collections, ThreadSafeWriter& self,
+                    std::optional<uint64_t> sequence) override {
+      if constexpr (detail::EncodingWriter<T>) {
+        auto encoded =
+            prepare(self, category, sequence, [&]() { return m_writer->encodeFrame(frame, category, collections); });
+        const Turn turn{self, category, sequence};
+        m_writer->writeEncodedFrame(std::move(encoded));
+      } else {
+        // Preparing the collections for writing does not need exclusive access
+        prepare(self, category, sequence, [&]() {
+          for (const auto& name : collections) {
+            frame.getCollectionForWrite(name);
+          }
+        });
+        const Turn turn{self, category, sequence};
+        m_writer->writeFrame(frame, category, collections);
+      }
+    }
+    void finish() override {
+      return m_writer->finish();
+    }
+    std::unique_ptr<T> m_writer{nullptr};
+  };
+
+public:
+  /// Create a ThreadSafeWriter from a lower level writer
+  ///
+  /// @tparam T the type of the low level writer (will be deduced)
+  /// @param writer A low level writer that does the actual work
+  ///
+  /// @note This enables ROOT's thread safety (ROOT::EnableThreadSafety), since
+  /// the writer is used from several threads
+  template <typename T>
+  ThreadSafeWriter(std::unique_ptr<T> writer) :
+      ThreadSafeWriter(std::unique_ptr<WriterConcept>(std::make_unique<WriterModel<T>>(std::move(writer)))) {
+  }
+
+  /// Destructor
+  ///
+  /// This also takes care of writing all the necessary metadata to read files
+  /// back again.
+  ~ThreadSafeWriter();
+
+  /// The ThreadSafeWriter is not copy-able
+  ThreadSafeWriter(const ThreadSafeWriter&) = delete;
+  /// The ThreadSafeWriter is not copy-able
+  ThreadSafeWriter& operator=(const ThreadSafeWriter&) = delete;
+  /// The ThreadSafeWriter is not move-able, since other threads might use it
+  ThreadSafeWriter(ThreadSafeWriter&&) = delete;
+  /// The ThreadSafeWriter is not move-able, since other threads might use it
+  ThreadSafeWriter& operator=(ThreadSafeWriter&&) = delete;
+
+  /// Store the given Frame with the given category.
+  ///
+  /// This stores all available collections from the Frame.
+  ///
+  /// @param frame    The Frame to store
+  /// @param category The category name under which this Frame should be stored
+  void writeFrame(const podio::Frame& frame, const std::string& category);
+
+  /// Store the given Frame with the given category.
+  ///
+  /// This stores only the desired collections and not the complete frame.
+  ///
+  /// @param frame        The Frame to store
+  /// @param category     The category name under which this Frame should be
+  ///                     stored
+  /// @param collsToWrite The collection names that should be written
+  void writeFrame(const podio::Frame& frame, const std::string& category, const std::vector<std::string>& collsToWrite);
+
+  /// Store the given Frame with the given category at the position in the
+  /// category that is defined by the sequence number
+  ///
+  /// This stores all available collections from the Frame.
+  ///
+  /// @param frame    The Frame to store
+  /// @param category The category name under which this Frame should be stored
+  /// @param sequence The sequence number of the Frame in its category
+  void writeFrame(const podio::Frame& frame, const std::string& category, uint64_t sequence);
+
+  /// Store the given Frame with the given category at the position in the
+  /// category that is defined by the sequence number
+  ///
+  /// This stores only the desired collections and not the complete frame.
+  ///
+  /// @param frame        The Frame to store
+  /// @param category     The category name under which this Frame should be
+  ///                     stored
+  /// @param collsToWrite The collection names that should be written
+  /// @param sequence     The sequence number of the Frame in its category
+  void writeFrame(const podio::Frame& frame, const std::string& category, const std::vector<std::string>& collsToWrite,
+                  uint64_t sequence);
+
+  /// Write the current file, including all the necessary metadata to read it
+  /// again.
+  ///
+  /// @note This must only be called once all threads are done with writing
+  void finish();
+
+private:
+  ThreadSafeWriter(std::unique_ptr<WriterConcept> writer);
+
+  void checkNotFinished();
+
+  std::unique_ptr<WriterConcept> m_self{nullptr};             ///< The writer that does the actual work
+  std::mutex m_mtx{};                                         ///< Serializes the access to the writer
+  std::condition_variable m_cv{};                             ///< Signals that a Frame of a sequence has been written
+  std::unordered_map<std::string, uint64_t> m_nextSequence{}; ///< The next sequence number per category
+  bool m_finished{false};                                     ///< Whether finish has been called already
+};
+
+/// Create a ThreadSafeWriter that is able to write files for the desired
+/// backend from several threads
+///
+/// @param filename The filename of the output file that will be created.
+/// @param type     The (optional) type argument, see makeWriter
+/// @param options  The (optional) options for writing, see makeWriter
+///
+/// @returns A fully initialized ThreadSafeWriter for the I/O backend that has
+///          been determined
+///
+/// @throws std::runtime_error In case the suffix can not be associated to an
+///         I/O backend or if support for the desired I/O backend has not been built
+ThreadSafeWriter makeThreadSafeWriter(const std::string& filename, const std::string& type = "default",
+                                      const WriterOptions& options = {});
+
+} // namespace podio
+
+#endif // PODIO_THREADSAFEWRITER_H
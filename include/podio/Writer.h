@@ -2,6 +2,7 @@
 #define PODIO_WRITER_H
 
 #include "podio/Frame.h"
+#include "podio/WriterOptions.h"
 
 namespace podio {
 
@@ -25,6 +26,8 @@ private:
 
     virtual void writeFrame(const podio::Frame& frame, const std::string& category,
                             const std::vector<std::string>& collections) = 0;
+    virtual void writeFrame(podio::Frame&& frame, const std::string& category,
+                            const std::vector<std::string>& collections) = 0;
     virtual void finish() = 0;
   };
 
@@ -44,6 +47,12 @@ private:
                     const std::vector<std::string>& collections) override {
       return m_writer->writeFrame(frame, category, collections);
     }
+    // Writers without a dedicated overload for rvalues simply bind to the const
+    // reference overload
+    void writeFrame(podio::Frame&& frame, const std::string& category,
+                    const std::vector<std::string>& collections) override {
+      return m_writer->writeFrame(std::move(frame), category, collections);
+    }
     void finish() override {
       return m_writer->finish();
     }
@@ -94,6 +103,32 @@ public:
     return m_self->writeFrame(frame, category, collections);
   }
 
+  /// Store the given frame with the given category, handing over ownership
+  /// of the Frame to the writer.
+  ///
+  /// For most writers this is the same as writing a const Frame, but e.g. the
+  /// AsyncWriter can then write the Frame in the background.
+  ///
+  /// @param frame    The frame to write
+  /// @param category The category name under which this frame should be stored
+  void writeFrame(podio::Frame&& frame, const std::string& category) {
+    const auto collections = frame.getAvailableCollections();
+    return m_self->writeFrame(std::move(frame), category, collections);
+  }
+
+  /// Store the given Frame with the given category, handing over ownership of
+  /// the Frame to the writer.
+  ///
+  /// This stores only the desired collections and not the complete frame.
+  ///
+  /// @param frame        The Frame to store
+  /// @param category     The category name under which this Frame should be
+  ///                     stored
+  /// @param collections  The collection names that should be written
+  void writeFrame(podio::Frame&& frame, const std::string& category, const std::vector<std::string>& collections) {
+    return m_self->writeFrame(std::move(frame), category, collections);
+  }
+
   /// Store the given frame under the "events" category
   ///
   /// This stores all available categories from the passed frame
@@ -113,6 +148,27 @@ public:
     writeFrame(frame, podio::Category::Event, collections);
   }
 
+  /// Store the given frame under the "events" category, handing over
+  /// ownership of the Frame to the writer.
+  ///
+  /// This stores all available categories from the passed frame
+  ///
+  /// @param frame    The frame to write
+  void writeEvent(podio::Frame&& frame) {
+    writeFrame(std::move(frame), podio::Category::Event);
+  }
+
+  /// Store the given Frame under the "events" category, handing over ownership
+  /// of the Frame to the writer.
+  ///
+  /// This stores only the desired collections and not the complete frame.
+  ///
+  /// @param frame        The Frame to store
+  /// @param collections  The collection names that should be written
+  void writeEvent(podio::Frame&& frame, const std::vector<std::string>& collections) {
+    writeFrame(std::move(frame), podio::Category::Event, collections);
+  }
+
   /// Write the current file, including all the necessary metadata to read it
   /// again.
   ///
@@ -132,13 +188,18 @@ public:
 /// @param type     The (optional) type argument to switch between RNTuple and TTree
 ///                 based backend in case the suffix is ".root". Will be ignored
 ///                 in case the suffix is ".sio"
+/// @param options  The (optional) options for writing, e.g. the compression
+///                 settings. These are passed on to the low level writer
 ///
 /// @returns A fully initialized Writer for the I/O backend that has been
 ///         determined
 ///
 /// @throws std::runtime_error In case the suffix can not be associated to an
 ///         I/O backend or if support for the desired I/O backend has not been built
-Writer makeWriter(const std::string& filename, const std::string& type = "default");
+/// @throws std::invalid_argument In case the desired I/O backend does not
+///         support the requested compression settings
+Writer makeWriter(const std::string& filename, const std::string& type = "default",
+                  const WriterOptions& options = {});
 
 } // namespace podio
 
@@ -0,0 +1,124 @@
+#ifndef PODIO_WRITEROPTIONS_H
+#define PODIO_WRITEROPTIONS_H
+
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace podio {
+
+/// The compression algorithms that can be chosen for writing files
+///
+/// @note Not all I/O backends support all codecs. Writers throw a
+/// std::invalid_argument on construction if an unsupported codec is requested
+enum class CompressionCodec {
+  Default, ///< Use whatever the I/O backend uses by default
+  None,    ///< Do not compress the data at all
+  Zlib,    ///< zlib (supported by all backends)
+  LZ4,     ///< LZ4, fast (de)compression at the cost of larger files (ROOT only)
+  ZSTD,    ///< ZSTD, good compression ratios at moderate speed (ROOT only)
+};
+
+/// The compression codec and level that should be used for writing
+struct CompressionSettings {
+  /// The default compression level of a codec, if no explicit level is set
+  static constexpr int defaultLevel(CompressionCodec codec) {
+    switch (codec) {
+    case CompressionCodec::None:
+      return 0;
+    case CompressionCodec::LZ4:
+      return 4;
+    case CompressionCodec::ZSTD:
+      return 5;
+    default:
+      return 6;
+    }
+  }
+
+  CompressionCodec codec{CompressionCodec::Default}; ///< The compression algorithm
+  /// The compression level (0 - 9), a negative value selects the default level
+  /// of the codec
+  int level{-1};
+
+  /// Get the compression level that should actually be used, i.e. with the
+  /// defaults resolved
+  int getLevel() const {
+    if (codec == CompressionCodec::None) {
+      return 0;
+    }
+    return level < 0 ? defaultLevel(codec) : level;
+  }
+
+  bool operator==(const CompressionSettings&) const = default;
+};
+
+/// Options that can be passed to the writers to configure the output that is
+/// produced.
+///
+/// Compression can be configured globally and be overridden for single
+/// categories, e.g. to use a fast codec for the events and a stronger one for
+/// the rarely written metadata
+///
+/// @code
+/// auto options = podio::WriterOptions{}.setCompression(podio::CompressionCodec::LZ4);
+/// options.setCompression(podio::Category::Metadata, podio::CompressionCodec::ZSTD, 9);
+/// auto writer = podio::makeWriter("output.root", "default", options);
+/// @endcode
+struct WriterOptions {
+  /// Set the compression that is used for all categories that have no
+  /// dedicated compression settings
+  ///
+  /// @throws std::invalid_argument if the level is larger than 9
+  WriterOptions& setCompression(CompressionCodec codec, int level = -1) {
+    compression = makeSettings(codec, level);
+    return *this;
+  }
+
+  /// Set the compression that is used for the passed category
+  ///
+  /// @throws std::invalid_argument if the level is larger than 9
+  WriterOptions& setCompression(const std::string& category, CompressionCodec codec, int level = -1) {
+    categoryCompression[category] = makeSettings(codec, level);
+    return *this;
+  }
+
+  /// Set the number of threads that are used for compressing the data of a
+  /// Frame. 0 uses the available hardware concurrency. The writer starts these
+  /// threads once and uses them for all Frames
+  ///
+  /// @note Currently only the SIOWriter compresses in parallel
+  WriterOptions& setCompressionThreads(unsigned nThreads) {
+    compressionThreads = nThreads;
+    return *this;
+  }
+
+  /// Get the compression settings that should be used for the passed category
+  const CompressionSettings& getCompression(const std::string& category) const {
+    if (const auto it = categoryCompression.find(category); it != categoryCompression.end()) {
+      return it->second;
+    }
+    return compression;
+  }
+
+  /// Check whether the passed category has dedicated compression settings
+  bool hasCategoryCompression(const std::string& category) const {
+    return categoryCompression.find(category) != categoryCompression.end();
+  }
+
+  CompressionSettings compression{}; ///< The global compression settings
+  /// The compression settings for categories that do not use the global ones
+  std::unordered_map<std::string, CompressionSettings> categoryCompression{};
+  unsigned compressionThreads{1}; ///< The number of threads to use for compressing a Frame
+
+private:
+  static CompressionSettings makeSettings(CompressionCodec codec, int level) {
+    if (level > 9) {
+      throw std::invalid_argument("Compression level " + std::to_string(level) + " is out of range (0 - 9)");
+    }
+    return {codec, level};
+  }
+};
+
+} // namespace podio
+
+#endif // PODIO_WRITEROPTIONS_H
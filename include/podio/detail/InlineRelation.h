@@ -0,0 +1,110 @@
+#ifndef PODIO_DETAIL_INLINERELATION_H
+#define PODIO_DETAIL_INLINERELATION_H
+
+#include "podio/CollectionBase.h"
+#include "podio/ObjectID.h"
+
+#include <memory>
+
+namespace podio::detail {
+
+/// Storage for a OneToOneRelation that does not need any heap allocation when
+/// the relation is read.
+///
+/// Relations that have been read only store the ObjectID of the related object
+/// together with a pointer to the collection that holds it and a function for
+/// creating the handle from these. The handle is only created once it is
+/// requested. Relations that are set by users still store a copy of the passed
+/// handle, since the related object might not yet be part of a collection.
+///
+/// This class only requires the RelType to be complete where its handle is
+/// created or destroyed, such that it can be used in the Objs with only a
+/// forward declaration.
+///
+/// @tparam RelType The type of the related object
+template <typename RelType>
+class InlineRelation {
+public:
+  /// The function that creates the handle from the collection and the ObjectID
+  using MakeFunc = RelType (*)(const podio::CollectionBase*, const podio::ObjectID);
+
+  InlineRelation() = default;
+  ~InlineRelation() = default;
+  InlineRelation(InlineRelation&&) = default;
+  InlineRelation& operator=(InlineRelation&&) = default;
+
+  /// Copying does a deep copy of a relation that has been set by users
+  InlineRelation(const InlineRelation& other) :
+      m_id(other.m_id),
+      m_coll(other.m_coll),
+      m_make(other.m_make),
+      m_value(other.m_value ? std::make_unique<RelType>(*other.m_value) : nullptr) {
+  }
+
+  InlineRelation& operator=(const InlineRelation& other) {
+    if (this != &other) {
+      auto tmp = InlineRelation(other);
+      *this = std::move(tmp);
+    }
+    return *this;
+  }
+
+  /// Point the relation to the element with the passed ObjectID in the passed
+  /// collection. The handle will be created using the passed function once it
+  /// is requested
+  void resolve(const podio::CollectionBase* coll, const podio::ObjectID id, MakeFunc make) {
+    m_value.reset();
+    m_id = id;
+    m_coll = coll;
+    m_make = make;
+  }
+
+  /// Set the related object from a handle
+  void set(const RelType& value) {
+    m_value = std::make_unique<RelType>(value);
+    m_coll = nullptr;
+    m_make = nullptr;
+  }
+
+  /// Unset the relation
+  void reset() {
+    m_value.reset();
+    m_coll = nullptr;
+    m_make = nullptr;
+  }
+
+  /// Check whether the relation is set
+  explicit operator bool() const {
+    return m_value || m_coll;
+  }
+
+  /// Get the related object. The relation has to be set
+  RelType get() const {
+    if (m_value) {
+      return *m_value;
+    }
+    return m_make(m_coll, m_id);
+  }
+
+  /// Get the ObjectID of the related object, or an invalid ObjectID if the
+  /// relation is not set
+  podio::ObjectID getObjectID() const {
+    if (m_value) {
+      return m_value->getObjectID();
+    }
+    if (m_coll) {
+      return m_id;
+    }
+    return {podio::ObjectID::invalid, 0};
+  }
+
+private:
+  podio::ObjectID m_id{};                       ///< The ObjectID of a related object that has been read
+  const podio::CollectionBase* m_coll{nullptr}; ///< The collection of a related object that has been read
+  MakeFunc m_make{nullptr};                     ///< Creates the handle of a related object that has been read
+  std::unique_ptr<RelType> m_value{nullptr};    ///< The related object if it has been set by users
+};
+
+} // namespace podio::detail
+
+#endif // PODIO_DETAIL_INLINERELATION_H
@@ -45,7 +45,11 @@ public:
   ~LinkCollectionData() = default;
 
   podio::CollectionWriteBuffers getCollectionBuffers(bool isSubsetColl) {
-    return {isSubsetColl ? nullptr : (void*)&m_data, (void*)m_data.get(), &m_refCollections, &m_vecInfo};
+    auto nBytes = podio::CollectionWriteBuffers::referencesSize(m_refCollections);
+    if (!isSubsetColl) {
+      nBytes += m_data->size() * sizeof(podio::LinkData);
+    }
+    return {isSubsetColl ? nullptr : (void*)&m_data, (void*)m_data.get(), &m_refCollections, &m_vecInfo, nBytes};
   }
 
   void clear(bool isSubsetColl) {
@@ -129,11 +133,13 @@ public:
   }
 
   bool setReferences(const podio::ICollectionProvider* collectionProvider, bool isSubsetColl) {
+    // Resolve every referenced collection only once
+    auto resolver = podio::detail::CollectionResolver(collectionProvider);
+
     if (isSubsetColl) {
       for (const auto& id : *m_refCollections[0]) {
-        podio::CollectionBase* coll{nullptr};
         LinkObj<FromT, ToT>* obj{nullptr};
-        if (collectionProvider->get(id.collectionID, coll)) {
+        if (auto* coll = resolver.get(id.collectionID)) {
           auto* tmp_coll = static_cast<LinkCollection<FromT, ToT>*>(coll);
           obj = tmp_coll->m_storage.entries[id.index];
         }
@@ -143,29 +149,31 @@ public:
     }
 
     // Normal collections have to resolve all relations
+    auto fromTypeResolver = podio::detail::InterfaceTypeResolver<FromT>{};
     for (size_t i = 0; i < entries.size(); ++i) {
       const auto id = (*m_refCollections[0])[i];
       if (id.index != podio::ObjectID::invalid) {
-        podio::CollectionBase* coll = nullptr;
-        if (!collectionProvider->get(id.collectionID, coll)) {
+        const auto* coll = resolver.get(id.collectionID);
+        if (!coll) {
           entries[i]->m_from = nullptr;
           continue;
         }
-        podio::detail::addSingleRelation(entries[i]->m_from, coll, id);
+        podio::detail::addSingleRelation(entries[i]->m_from, coll, id, fromTypeResolver);
       } else {
         entries[i]->m_from = nullptr;
       }
     }
 
+    auto toTypeResolver = podio::detail::InterfaceTypeResolver<ToT>{};
     for (size_t i = 0; i < entries.size(); ++i) {
       const auto id = (*m_refCollections[1])[i];
       if (id.index != podio::ObjectID::invalid) {
-        podio::CollectionBase* coll = nullptr;
-        if (!collectionProvider->get(id.collectionID, coll)) {
+        const auto* coll = resolver.get(id.collectionID);
+        if (!coll) {
           entries[i]->m_to = nullptr;
           continue;
         }
-        podio::detail::addSingleRelation(entries[i]->m_to, coll, id);
+        podio::detail::addSingleRelation(entries[i]->m_to, coll, id, toTypeResolver);
       } else {
         entries[i]->m_to = nullptr;
       }
@@ -1,46 +1,185 @@
 #ifndef PODIO_DETAIL_RELATIONIOHELPERS_H
 #define PODIO_DETAIL_RELATIONIOHELPERS_H
 
+#include "podio/detail/InlineRelation.h"
+#include "podio/detail/RelationTable.h"
 #include "podio/utilities/TypeHelpers.h"
 #include <podio/CollectionBase.h>
+#include <podio/ICollectionProvider.h>
 
+#include <array>
+#include <cstdint>
 #include <memory>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 namespace podio::detail {
 
-/// Function template for handling interface types in OneToMultiRelations
+/// Helper for resolving the collections that are referenced by the ObjectIDs
+/// of the relations of a collection when it is read.
 ///
-/// Effectively this function checks whether the passed collection can be
-/// dynamically cast to the collection type of the concrete type and if that is
-/// true uses it to construct an interface type and add it to relElements. The
-/// function on its own doesn't do anything too meaningful, it is meant to be
-/// used in a call to std::apply that goes over all the interfaced types of an
-/// interface type.
+/// Each collection is requested only once from the collection provider,
+/// all further lookups of the same collection ID are served from a cache. The
+/// ObjectIDs of a collection usually point into only a handful of different
+/// collections and typically long runs of them point into the same one, so a
+/// linear search with a fast path for the last used collection beats any
+/// hashing here.
+class CollectionResolver {
+public:
+  explicit CollectionResolver(const podio::ICollectionProvider* provider) : m_provider(provider) {
+  }
+
+  /// Get the collection with the given collection ID
+  ///
+  /// @param collectionID The ID of the collection that should be retrieved
+  ///
+  /// @returns A pointer to the collection or a nullptr if the collection
+  ///          provider does not have the collection
+  podio::CollectionBase* get(const uint32_t collectionID) {
+    if (m_lastIndex < m_resolved.size() && m_resolved[m_lastIndex].first == collectionID) {
+      return m_resolved[m_lastIndex].second;
+    }
+    for (size_t i = 0; i < m_resolved.size(); ++i) {
+      if (m_resolved[i].first == collectionID) {
+        m_lastIndex = i;
+        return m_resolved[i].second;
+      }
+    }
+
+    podio::CollectionBase* coll = nullptr;
+    if (!m_provider->get(collectionID, coll)) {
+      coll = nullptr;
+    }
+    m_lastIndex = m_resolved.size();
+    m_resolved.emplace_back(collectionID, coll);
+    return coll;
+  }
+
+private:
+  const podio::ICollectionProvider* m_provider{nullptr};
+  std::vector<std::pair<uint32_t, podio::CollectionBase*>> m_resolved{}; ///< All collections requested so far
+  size_t m_lastIndex{0};                                                 ///< The index of the last used collection
+};
+
+/// Get the index of the interfaced type of an interface type that is stored in
+/// the passed collection.
 ///
-/// @tparam T The concrete type inside the interface that should be checked.
-///           This effectively is mainly used for tag-dispatch and overload
-///           selection in this context
-/// @tparam InterfaceType The interface type (that can be used to interface T)
+/// The type is determined by comparing the type name of the collection with
+/// the ones of the collections of all interfaced types, i.e. without any RTTI.
 ///
-/// @param relElements The vector to which the interface objects should be added
+/// @tparam InterfaceType The interface type
+///
+/// @param coll The collection that holds elements of one of the interfaced types
+///
+/// @returns The index of the matching type in the interfaced_types or the
+///          number of interfaced types if none of them matches
+template <typename InterfaceType>
+size_t getInterfacedTypeIndex(const podio::CollectionBase* coll) {
+  using InterfacedTypes = typename InterfaceType::interfaced_types;
+  const auto typeName = coll->getTypeName();
+  return [&]<size_t... Is>(std::index_sequence<Is...>) {
+    size_t index = sizeof...(Is);
+    (void)((typeName == std::tuple_element_t<Is, InterfacedTypes>::collection_type::typeName ? (index = Is, true)
+                                                                                              : false) ||
+           ...);
+    return index;
+  }(std::make_index_sequence<std::tuple_size_v<InterfacedTypes>>{});
+}
+
+/// Get the function that creates an interface object from an element of a
+/// collection of one of its interfaced types.
+///
+/// @tparam InterfaceType The interface type
+///
+/// @param typeIndex The index of the type of the collection in the
+///                  interfaced_types (see getInterfacedTypeIndex)
+///
+/// @returns A function that creates the interface object from the collection
+///          and the ObjectID of the element
+template <typename InterfaceType>
+auto getInterfaceMaker(size_t typeIndex) {
+  using InterfacedTypes = typename InterfaceType::interfaced_types;
+  using MakeFunc = InterfaceType (*)(const podio::CollectionBase*, const podio::ObjectID);
+  // One function per interfaced type that can simply cast the collection,
+  // since the type has already been checked
+  constexpr auto makeFuncs = []<size_t... Is>(std::index_sequence<Is...>) {
+    return std::array<MakeFunc, sizeof...(Is)>{
+        [](const podio::CollectionBase* c, const podio::ObjectID objId) -> InterfaceType {
+          using T = std::tuple_element_t<Is, InterfacedTypes>;
+          return T((*static_cast<const typename T::collection_type*>(c))[objId.index]);
+        }...};
+  }(std::make_index_sequence<std::tuple_size_v<InterfacedTypes>>{});
+
+  return makeFuncs[typeIndex];
+}
+
+/// Create an interface object from an element of a collection of one of its
+/// interfaced types.
+///
+/// @tparam InterfaceType The interface type
+///
+/// @param typeIndex The index of the type of the collection in the
+///                  interfaced_types (see getInterfacedTypeIndex)
 /// @param coll The collection that holds the actual element
-/// @param id The ObjectID of the element that we are currently looking for
-template <typename T, typename InterfaceType>
-void tryAddTo(T, std::vector<InterfaceType>& relElements, const podio::CollectionBase* coll, const podio::ObjectID id) {
-  if (auto typedColl = dynamic_cast<const typename T::collection_type*>(coll)) {
-    const T tmp = (*typedColl)[id.index];
-    relElements.emplace_back(tmp);
-  }
+/// @param id The ObjectID of the element
+template <typename InterfaceType>
+InterfaceType makeInterface(size_t typeIndex, const podio::CollectionBase* coll, const podio::ObjectID id) {
+  return getInterfaceMaker<InterfaceType>(typeIndex)(coll, id);
 }
 
+/// Create a handle from an element of a collection of a (non-interface) type.
+///
+/// @tparam RelType The type of the element
+///
+/// @param coll The collection that holds the element
+/// @param id The ObjectID of the element
+template <typename RelType>
+RelType makeRelation(const podio::CollectionBase* coll, const podio::ObjectID id) {
+  return (*static_cast<const typename RelType::collection_type*>(coll))[id.index];
+}
+
+/// Cache for the interfaced type of the collections that are referenced by
+/// the interface relations of a collection.
+///
+/// The type is determined only once per referenced collection, afterwards
+/// looking it up only needs a comparison of the collection pointer in the
+/// common case that consecutive elements point into the same collection. For
+/// relations to non-interface types this does nothing.
+///
+/// @tparam RelType The type of the relation
+template <typename RelType>
+class InterfaceTypeResolver {
+public:
+  /// Get the index of the interfaced type that is stored in the passed
+  /// collection (see getInterfacedTypeIndex)
+  size_t get(const podio::CollectionBase* coll) {
+    if (coll == m_lastColl) {
+      return m_lastIndex;
+    }
+    m_lastColl = coll;
+    for (const auto& [resolvedColl, index] : m_resolved) {
+      if (resolvedColl == coll) {
+        m_lastIndex = index;
+        return index;
+      }
+    }
+    m_lastIndex = getInterfacedTypeIndex<RelType>(coll);
+    m_resolved.emplace_back(coll, m_lastIndex);
+    return m_lastIndex;
+  }
+
+private:
+  std::vector<std::pair<const podio::CollectionBase*, size_t>> m_resolved{}; ///< All collections seen so far
+  const podio::CollectionBase* m_lastColl{nullptr};                          ///< The last used collection
+  size_t m_lastIndex{0}; ///< The interfaced type index of the last used collection
+};
+
 /// Helper function for handling interface type relations in OneToManyRelations
 ///
-/// This function tries all types that are interfaced by the InterfaceType and
-/// adds the one that matches to the relations. The main work happens in
-/// tryAddTo, this simply wraps everything in a std::apply over all
-/// interfaced_types.
+/// This function determines which of the types that are interfaced by the
+/// InterfaceType is stored in the passed collection and adds the element to
+/// the relations.
 ///
 /// @tparam InterfaceType The interface type of the Relation
 ///
@@ -50,7 +189,10 @@ void tryAddTo(T, std::vector<InterfaceType>& relElements, const podio::Collectio
 template <typename InterfaceType>
 void addInterfaceToMultiRelation(std::vector<InterfaceType>& relElements, const podio::CollectionBase* coll,
                                  const podio::ObjectID id) {
-  std::apply([&](auto... t) { (tryAddTo(t, relElements, coll, id), ...); }, typename InterfaceType::interfaced_types{});
+  const auto typeIndex = getInterfacedTypeIndex<InterfaceType>(coll);
+  if (typeIndex < std::tuple_size_v<typename InterfaceType::interfaced_types>) {
+    relElements.emplace_back(makeInterface<InterfaceType>(typeIndex, coll, id));
+  }
 }
 
 /// Helper function for adding an object to the OneToManyRelations container
@@ -92,37 +234,73 @@ void addMultiRelation(std::vector<RelType>& relElements, const podio::Collection
   }
 }
 
-/// Function template for handling interface types in OneToOneRelations
+/// Helper function for adding an object to the OneToManyRelations container
+/// when reading back collections, using a cache for the interfaced types of
+/// the referenced collections.
 ///
-/// Effectively this function checks whether the passed collection can be
-/// dynamically cast to the collection type of the concrete type and if that is
-/// true uses it to assign to the passed interface object The function on its
-/// own doesn't do anything too meaningful, it is meant to be used in a call to
-/// std::apply that goes over all the interfaced types of an interface type.
+/// See the overload without a cache for more details
+template <typename RelType>
+void addMultiRelation(std::vector<RelType>& relElements, const podio::CollectionBase* coll, const podio::ObjectID id,
+                      InterfaceTypeResolver<RelType>& typeResolver) {
+  if constexpr (podio::detail::isInterfaceType<RelType>) {
+    const auto typeIndex = typeResolver.get(coll);
+    if (typeIndex < std::tuple_size_v<typename RelType::interfaced_types>) {
+      relElements.emplace_back(makeInterface<RelType>(typeIndex, coll, id));
+    }
+  } else {
+    addMultiRelation(relElements, coll, id);
+  }
+}
+
+/// Helper function for resolving the collections that the ObjectIDs of a
+/// RelationTable point into.
 ///
-/// @tparam T The concrete type inside the interface that should be checked.
-///           This effectively is mainly used for tag-dispatch and overload
-///           selection in this context
-/// @tparam InterfaceType The interface type (that can be used to interface T)
+/// Every referenced collection is resolved only once, no handles are created
+/// for the related objects. References to collections that are not available,
+/// or that do not hold one of the interfaced types for relations to interface
+/// types, will yield empty handles.
 ///
-/// @param relation The object to which the interface object should be assigned
-///                 to
-/// @param coll The collection that holds the actual element
-/// @param id The ObjectID of the element that we are currently looking for
-template <typename T, typename InterfaceType>
-void tryAssignTo(T, std::unique_ptr<InterfaceType>& relation, const podio::CollectionBase* coll,
-                 const podio::ObjectID id) {
-  if (const auto* typeColl = dynamic_cast<const typename T::collection_type*>(coll)) {
-    relation = std::make_unique<InterfaceType>((*typeColl)[id.index]);
+/// @tparam RelType The type of the OneToManyRelation
+///
+/// @param table The relation table that should be resolved
+/// @param ids The ObjectIDs of the related objects that are stored in the table
+/// @param resolver The resolver for the referenced collections
+/// @param typeResolver The cache for the interfaced types of the referenced
+///                     collections
+template <typename RelType>
+void resolveRelationTable(RelationTable<RelType>& table, const std::vector<podio::ObjectID>& ids,
+                          CollectionResolver& resolver, InterfaceTypeResolver<RelType>& typeResolver) {
+  auto lastCollID = static_cast<uint32_t>(podio::ObjectID::untracked);
+  for (const auto& id : ids) {
+    if (id.index == podio::ObjectID::invalid || id.collectionID == lastCollID) {
+      continue;
+    }
+    lastCollID = id.collectionID;
+    if (table.hasTarget(id.collectionID)) {
+      continue;
+    }
+
+    const auto* coll = resolver.get(id.collectionID);
+    typename RelationTable<RelType>::MakeFunc make = nullptr;
+    if (coll) {
+      if constexpr (podio::detail::isInterfaceType<RelType>) {
+        const auto typeIndex = typeResolver.get(coll);
+        if (typeIndex < std::tuple_size_v<typename RelType::interfaced_types>) {
+          make = getInterfaceMaker<RelType>(typeIndex);
+        }
+      } else {
+        make = &makeRelation<RelType>;
+      }
+    }
+    table.addTarget(id.collectionID, coll, make);
   }
 }
 
 /// Helper function for handling interface type relations in OneToOneRelations
 ///
-/// This function tries all types that are interfaced by the InterfaceType and
-/// that assigns the one thta matches to the relation. The main work happens in
-/// tryAssignTo, this simply wraps everything in a std::apply over all
-/// interfaced_types.
+/// This function determines which of the types that are interfaced by the
+/// InterfaceType is stored in the passed collection and assigns the element to
+/// the relation.
 ///
 /// @tparam InterfaceType The interface type of the Relation
 ///
@@ -133,7 +311,10 @@ void tryAssignTo(T, std::unique_ptr<InterfaceType>& relation, const podio::Colle
 template <typename InterfaceType>
 void addInterfaceToSingleRelation(std::unique_ptr<InterfaceType>& relation, const podio::CollectionBase* coll,
                                   const podio::ObjectID id) {
-  std::apply([&](auto... t) { (tryAssignTo(t, relation, coll, id), ...); }, typename InterfaceType::interfaced_types{});
+  const auto typeIndex = getInterfacedTypeIndex<InterfaceType>(coll);
+  if (typeIndex < std::tuple_size_v<typename InterfaceType::interfaced_types>) {
+    relation = std::make_unique<InterfaceType>(makeInterface<InterfaceType>(typeIndex, coll, id));
+  }
 }
 
 /// Helper function for assigning the related object in a OneToOneRelation
@@ -174,6 +355,51 @@ void addSingleRelation(std::unique_ptr<RelType>& relation, const podio::Collecti
   }
 }
 
+/// Helper function for assigning the related object in a OneToOneRelation,
+/// using a cache for the interfaced types of the referenced collections.
+///
+/// See the overload without a cache for more details
+template <typename RelType>
+void addSingleRelation(std::unique_ptr<RelType>& relation, const podio::CollectionBase* coll, const podio::ObjectID id,
+                       InterfaceTypeResolver<RelType>& typeResolver) {
+  if constexpr (podio::detail::isInterfaceType<RelType>) {
+    const auto typeIndex = typeResolver.get(coll);
+    if (typeIndex < std::tuple_size_v<typename RelType::interfaced_types>) {
+      relation = std::make_unique<RelType>(makeInterface<RelType>(typeIndex, coll, id));
+    }
+  } else {
+    addSingleRelation(relation, coll, id);
+  }
+}
+
+/// Helper function for resolving a OneToOneRelation that is stored inline in
+/// the Objs.
+///
+/// In contrast to the overloads for relations that are stored as pointers, this
+/// does not create the handle of the related object. Instead, it only stores
+/// the collection and the ObjectID together with the function that creates
+/// the handle once it is requested. The same pre-conditions apply.
+///
+/// @tparam RelType The type of the OneToOneRelation
+///
+/// @param relation The inline relation storage that should be resolved
+/// @param coll The collection that holds the related object
+/// @param id The ObjectID of the related object
+/// @param typeResolver The cache for the interfaced types of the referenced
+///                     collections
+template <typename RelType>
+void addSingleRelation(InlineRelation<RelType>& relation, const podio::CollectionBase* coll, const podio::ObjectID id,
+                       InterfaceTypeResolver<RelType>& typeResolver) {
+  if constexpr (podio::detail::isInterfaceType<RelType>) {
+    const auto typeIndex = typeResolver.get(coll);
+    if (typeIndex < std::tuple_size_v<typename RelType::interfaced_types>) {
+      relation.resolve(coll, id, getInterfaceMaker<RelType>(typeIndex));
+    }
+  } else {
+    relation.resolve(coll, id, &makeRelation<RelType>);
+  }
+}
+
 } // namespace podio::detail
 
 #endif // PODIO_DETAIL_RELATIONIOHELPERS_H
@@ -0,0 +1,209 @@
+#ifndef PODIO_DETAIL_RELATIONTABLE_H
+#define PODIO_DETAIL_RELATIONTABLE_H
+
+#include "podio/CollectionBase.h"
+#include "podio/ObjectID.h"
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace podio::detail {
+
+/// Storage for the OneToManyRelations of all elements of a collection that
+/// have been read.
+///
+/// Instead of creating a handle for every related object when a collection is
+/// read, this keeps the ObjectIDs of the related objects as they have been read
+/// and only resolves the collections they point into. The handles are created
+/// only once they are requested.
+///
+/// @tparam RelType The type of the related objects
+template <typename RelType>
+class RelationTable {
+public:
+  /// The function that creates the handle from the collection and the ObjectID
+  using MakeFunc = RelType (*)(const podio::CollectionBase*, const podio::ObjectID);
+
+  /// Create a table for the passed ObjectIDs, which have to outlive the table
+  explicit RelationTable(const std::vector<podio::ObjectID>* ids) : m_ids(ids) {
+  }
+
+  /// Check whether the collection with the passed ID has already been resolved
+  bool hasTarget(const uint32_t collectionID) const {
+    return findTarget(collectionID) != nullptr;
+  }
+
+  /// Add a resolved collection. Handles to elements of collections without a
+  /// collection or function are empty
+  void addTarget(const uint32_t collectionID, const podio::CollectionBase* coll, MakeFunc make) {
+    const auto it = std::ranges::lower_bound(m_targets, collectionID, {}, &Target::collectionID);
+    if (it != m_targets.end() && it->collectionID == collectionID) {
+      *it = {collectionID, coll, make};
+    } else {
+      m_targets.insert(it, {collectionID, coll, make});
+    }
+  }
+
+  /// Remove all resolved collections
+  void clear() {
+    m_targets.clear();
+  }
+
+  /// Get the related object at the passed index
+  RelType get(const size_t index) const {
+    const auto id = (*m_ids)[index];
+    if (id.index != podio::ObjectID::invalid) {
+      const auto* target = findTarget(id.collectionID);
+      if (target && target->make) {
+        return target->make(target->coll, id);
+      }
+    }
+    return RelType::makeEmpty();
+  }
+
+private:
+  struct Target {
+    uint32_t collectionID{};
+    const podio::CollectionBase* coll{nullptr};
+    MakeFunc make{nullptr};
+  };
+
+  /// Get the resolved collection with the passed ID, or a nullptr if it has
+  /// not been resolved
+  const Target* findTarget(const uint32_t collectionID) const {
+    const auto it = std::ranges::lower_bound(m_targets, collectionID, {}, &Target::collectionID);
+    if (it != m_targets.end() && it->collectionID == collectionID) {
+      return &*it;
+    }
+    return nullptr;
+  }
+
+  const std::vector<podio::ObjectID>* m_ids{nullptr}; ///< The ObjectIDs of the related objects
+  std::vector<Target> m_targets{};                    ///< All resolved collections, sorted by their ID
+};
+
+/// Iterator over the OneToManyRelations of an object, that either points into
+/// the RelationTable of the collection it has been read from, or into the
+/// handles that have been added to it.
+///
+/// Dereferencing creates the handle from the RelationTable and returns it by
+/// value, so these are only input iterators in terms of the legacy iterator
+/// categories. They model std::random_access_iterator, which is what the
+/// std::ranges algorithms and e.g. std::ranges::distance use.
+///
+/// @tparam RelType The type of the related objects
+template <typename RelType>
+class RelationTableIterator {
+public:
+  using value_type = RelType;
+  using difference_type = ptrdiff_t;
+  using reference = RelType;
+  using pointer = void;
+  // operator* returns a handle that is created on the fly, not a reference
+  using iterator_category = std::input_iterator_tag;
+  using iterator_concept = std::random_access_iterator_tag;
+
+  RelationTableIterator(const RelationTable<RelType>* table, const std::vector<RelType>* handles, size_t index) :
+      m_table(table), m_handles(handles), m_index(index) {
+  }
+  RelationTableIterator() = default;
+
+  RelationTableIterator(const RelationTableIterator&) = default;
+  RelationTableIterator(RelationTableIterator&&) = default;
+  RelationTableIterator& operator=(const RelationTableIterator&) = default;
+  RelationTableIterator& operator=(RelationTableIterator&&) = default;
+  ~RelationTableIterator() = default;
+
+  bool operator!=(const RelationTableIterator& x) const {
+    return m_index != x.m_index;
+  }
+
+  bool operator==(const RelationTableIterator& x) const {
+    return m_index == x.m_index;
+  }
+
+  std::strong_ordering operator<=>(const RelationTableIterator& x) const {
+    return m_index <=> x.m_index;
+  }
+
+  /// Holds the handle that is created when dereferencing via operator->
+  struct ArrowProxy {
+    RelType handle;
+    const RelType* operator->() const {
+      return &handle;
+    }
+  };
+
+  reference operator*() const {
+    return m_table ? m_table->get(m_index) : (*m_handles)[m_index];
+  }
+
+  ArrowProxy operator->() const {
+    return {**this};
+  }
+
+  reference operator[](difference_type n) const {
+    return *(*this + n);
+  }
+
+  RelationTableIterator& operator++() {
+    ++m_index;
+    return *this;
+  }
+
+  RelationTableIterator operator++(int) {
+    auto copy = *this;
+    ++m_index;
+    return copy;
+  }
+
+  RelationTableIterator& operator--() {
+    --m_index;
+    return *this;
+  }
+
+  RelationTableIterator operator--(int) {
+    auto copy = *this;
+    --m_index;
+    return copy;
+  }
+
+  RelationTableIterator& operator+=(difference_type n) {
+    m_index += n;
+    return *this;
+  }
+
+  RelationTableIterator& operator-=(difference_type n) {
+    m_index -= n;
+    return *this;
+  }
+
+  friend RelationTableIterator operator+(RelationTableIterator it, difference_type n) {
+    return it += n;
+  }
+
+  friend RelationTableIterator operator+(difference_type n, RelationTableIterator it) {
+    return it += n;
+  }
+
+  friend RelationTableIterator operator-(RelationTableIterator it, difference_type n) {
+    return it -= n;
+  }
+
+  friend difference_type operator-(const RelationTableIterator& x, const RelationTableIterator& y) {
+    return static_cast<difference_type>(x.m_index) - static_cast<difference_type>(y.m_index);
+  }
+
+private:
+  const RelationTable<RelType>* m_table{nullptr}; ///< The table of a read object
+  const std::vector<RelType>* m_handles{nullptr}; ///< The added handles otherwise
+  size_t m_index{0};
+};
+
+} // namespace podio::detail
+
+#endif // PODIO_DETAIL_RELATIONTABLE_H
@@ -22,6 +22,14 @@ public:
   /// @param name The name under which this collection is stored on file
   void registerDatamodelDefinition(const podio::CollectionBase* coll, const std::string& name);
 
+  /// Register all the datamodel definitions that have been registered with
+  /// another collector
+  ///
+  /// @param other Another collector
+  void merge(const DatamodelDefinitionCollector& other) {
+    m_edmDefRegistryIdcs.insert(other.m_edmDefRegistryIdcs.begin(), other.m_edmDefRegistryIdcs.end());
+  }
+
   /// Get all the names and JSON definitions that need to be written
   std::vector<std::tuple<std::string, std::string>> getDatamodelDefinitionsToWrite() const;
 
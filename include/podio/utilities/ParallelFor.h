@@ -0,0 +1,81 @@
+#ifndef PODIO_UTILITIES_PARALLELFOR_H
+#define PODIO_UTILITIES_PARALLELFOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace podio::utils {
+
+/// Get the number of threads that should be used if no explicit number has
+/// been requested (i.e. 0 has been passed)
+inline unsigned defaultNumThreads(unsigned nThreads = 0) {
+  if (nThreads > 0) {
+    return nThreads;
+  }
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/// Call func(i) for all i in [0, nTasks) using up to nThreads threads.
+///
+/// The calling thread takes part in the work and the tasks are handed out
+/// dynamically, such that tasks of differing sizes are balanced between the
+/// threads. The first exception that is thrown by any of the tasks is
+/// re-thrown on the calling thread after all threads have finished. Tasks that
+/// have not yet been started at that point will not be run.
+///
+/// @param nTasks   The number of tasks
+/// @param nThreads The maximum number of threads to use (including the calling
+///                 one). 0 uses the available hardware concurrency
+/// @param func     The function to call for each task index
+template <typename FuncT>
+void parallelFor(size_t nTasks, unsigned nThreads, FuncT&& func) {
+  const auto nWorkers = std::min<size_t>(defaultNumThreads(nThreads), nTasks);
+  if (nWorkers <= 1) {
+    for (size_t i = 0; i < nTasks; ++i) {
+      func(i);
+    }
+    return;
+  }
+
+  std::atomic<size_t> nextTask{0};
+  std::exception_ptr firstException{nullptr};
+  std::mutex exceptionMtx{};
+
+  auto worker = [&]() {
+    for (auto i = nextTask++; i < nTasks; i = nextTask++) {
+      try {
+        func(i);
+      } catch (...) {
+        std::lock_guard lock{exceptionMtx};
+        if (!firstException) {
+          firstException = std::current_exception();
+        }
+        // Make sure that no further tasks are started
+        nextTask = nTasks;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(nWorkers - 1);
+  for (size_t i = 0; i < nWorkers - 1; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  if (firstException) {
+    std::rethrow_exception(firstException);
+  }
+}
+
+} // namespace podio::utils
+
+#endif // PODIO_UTILITIES_PARALLELFOR_H
@@ -57,19 +57,29 @@ namespace root_utils {
     ParamStorage(ParamStorage&&) = default;
     ParamStorage& operator=(ParamStorage&&) = default;
 
-    ParamStorage(std::tuple<std::vector<std::string>, std::vector<std::vector<T>>> keysValues) :
-        keys(std::move(std::get<0>(keysValues))), values(std::move(std::get<1>(keysValues))) {
+    /// Use the keys and values of the passed storage instead of the stored ones.
+    /// This allows to write the parameters without copying them first. The
+    /// branches need non-const addresses, but filling only reads from them.
+    /// The storage has to come from a GenericParameters::LockedView that is
+    /// kept alive until the entry has been filled
+    void bind(const GenericParameters::Storage<T>& storage) {
+      m_keysPtr = const_cast<std::vector<std::string>*>(&storage.keys);
+      m_valuesPtr = const_cast<std::vector<std::vector<T>>*>(&storage.values);
     }
 
-    /// Get a pointer to the stored keys for binding it to a TBranch
+    /// Get a pointer to the stored (or bound) keys for binding it to a TBranch
     auto keysPtr() {
-      m_keysPtr = &keys;
+      if (!m_keysPtr) {
+        m_keysPtr = &keys;
+      }
       return &m_keysPtr;
     }
 
-    /// Get a pointer to the stored vectors for binding it to a TBranch
+    /// Get a pointer to the stored (or bound) vectors for binding it to a TBranch
     auto valuesPtr() {
-      m_valuesPtr = &values;
+      if (!m_valuesPtr) {
+        m_valuesPtr = &values;
+      }
       return &m_valuesPtr;
     }
 
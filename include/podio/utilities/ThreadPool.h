@@ -0,0 +1,182 @@
+#ifndef PODIO_UTILITIES_THREADPOOL_H
+#define PODIO_UTILITIES_THREADPOOL_H
+
+#include "podio/utilities/ParallelFor.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace podio::utils {
+
+/// A fixed set of worker threads that are started once and then used for all
+/// calls to parallelFor, instead of starting new threads for every call.
+///
+/// parallelFor behaves like the free podio::utils::parallelFor function: the
+/// calling thread takes part in the work, the tasks are handed out dynamically
+/// and the first exception is re-thrown on the calling thread. It can be
+/// called from several threads at the same time, in which case the workers
+/// help with all of the calls in the order in which they have been made.
+class ThreadPool {
+public:
+  /// Create a pool for running tasks on nThreads threads in total, i.e. the
+  /// pool starts nThreads - 1 workers, since the calling thread also works. 0
+  /// uses the available hardware concurrency
+  explicit ThreadPool(unsigned nThreads) {
+    const auto nWorkers = defaultNumThreads(nThreads) - 1;
+    m_workers.reserve(nWorkers);
+    for (unsigned i = 0; i < nWorkers; ++i) {
+      m_workers.emplace_back([this]() { work(); });
+    }
+  }
+
+  /// Stop and join all workers. parallelFor must no longer be running
+  ~ThreadPool() {
+    {
+      std::lock_guard lock{m_mtx};
+      m_stop = true;
+    }
+    m_cv.notify_all();
+    for (auto& worker : m_workers) {
+      worker.join();
+    }
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ThreadPool(ThreadPool&&) = delete;
+  ThreadPool& operator=(ThreadPool&&) = delete;
+
+  /// The number of threads that work on the tasks of one call to parallelFor,
+  /// including the calling thread
+  unsigned size() const {
+    return static_cast<unsigned>(m_workers.size()) + 1;
+  }
+
+  /// Call func(i) for all i in [0, nTasks) on the calling thread and the
+  /// workers of the pool. Returns once all tasks are done.
+  ///
+  /// @param nTasks The number of tasks
+  /// @param func   The function to call for each task index
+  template <typename FuncT>
+  void parallelFor(size_t nTasks, FuncT&& func) {
+    if (nTasks <= 1 || m_workers.empty()) {
+      for (size_t i = 0; i < nTasks; ++i) {
+        func(i);
+      }
+      return;
+    }
+
+    auto job = std::make_shared<Job>(nTasks, std::function<void(size_t)>(std::ref(func)));
+    {
+      std::lock_guard lock{m_mtx};
+      m_jobs.push_back(job);
+    }
+    m_cv.notify_all();
+
+    runTasks(*job);
+
+    std::unique_lock lock{m_mtx};
+    std::erase(m_jobs, job);
+    m_cv.wait(lock, [&job]() { return job->nActive == 0; });
+    if (job->error) {
+      std::rethrow_exception(job->error);
+    }
+  }
+
+private:
+  /// The tasks of one call to parallelFor
+  struct Job {
+    Job(size_t n, std::function<void(size_t)> f) : nTasks(n), func(std::move(f)) {
+    }
+    size_t nTasks;
+    std::function<void(size_t)> func;
+    std::atomic<size_t> next{0}; ///< The next task to hand out
+    unsigned nActive{0};         ///< The number of workers that are running tasks of this job
+    std::exception_ptr error{};  ///< The first exception that has been thrown by a task
+  };
+
+  /// Run tasks of the job until there are none left
+  void runTasks(Job& job) {
+    for (auto i = job.next++; i < job.nTasks; i = job.next++) {
+      try {
+        job.func(i);
+      } catch (...) {
+        std::lock_guard lock{m_mtx};
+        if (!job.error) {
+          job.error = std::current_exception();
+        }
+        // Make sure that no further tasks are started
+        job.next = job.nTasks;
+      }
+    }
+  }
+
+  /// The loop of the workers
+  void work() {
+    std::unique_lock lock{m_mtx};
+    while (true) {
+      std::shared_ptr<Job> job{nullptr};
+      m_cv.wait(lock, [this, &job]() {
+        for (const auto& j : m_jobs) {
+          if (j->next < j->nTasks) {
+            job = j;
+            return true;
+          }
+        }
+        return m_stop;
+      });
+      if (!job) {
+        return;
+      }
+
+      // Once the job is registered as active, its caller waits for us
+      job->nActive++;
+      lock.unlock();
+      runTasks(*job);
+      lock.lock();
+      job->nActive--;
+      m_cv.notify_all();
+    }
+  }
+
+  std::mutex m_mtx{};                        ///< Guards the jobs and the stop flag
+  std::condition_variable m_cv{};            ///< Signals new jobs, finished workers and stopping
+  std::deque<std::shared_ptr<Job>> m_jobs{}; ///< The jobs that might still have tasks to hand out
+  bool m_stop{false};                        ///< Whether the workers should stop
+  std::vector<std::thread> m_workers{};      ///< The worker threads
+};
+
+/// Get the process wide pool with the given number of threads, which is
+/// created on first use and then shared by all its users (e.g.
+/// Frame::prefetch). 0 uses the available hardware concurrency. Calling this
+/// from several threads at the same time is safe.
+///
+/// @param nThreads The number of threads that work on the tasks of one call to
+///                 parallelFor, including the calling thread
+///
+/// @returns The pool, which lives until the end of the program
+inline ThreadPool& sharedThreadPool(unsigned nThreads = 0) {
+  static std::mutex poolsMtx{};
+  static std::map<unsigned, std::unique_ptr<ThreadPool>> pools{};
+
+  nThreads = defaultNumThreads(nThreads);
+  std::lock_guard lock{poolsMtx};
+  auto& pool = pools[nThreads];
+  if (!pool) {
+    pool = std::make_unique<ThreadPool>(nThreads);
+  }
+  return *pool;
+}
+
+} // namespace podio::utils
+
+#endif // PODIO_UTILITIES_THREADPOOL_H
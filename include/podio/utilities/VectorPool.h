@@ -0,0 +1,174 @@
+#ifndef PODIO_UTILITIES_VECTORPOOL_H
+#define PODIO_UTILITIES_VECTORPOOL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace podio::utils {
+
+/// A thread safe pool of heap allocated vectors that keep their capacity when
+/// they are returned to the pool, such that they can be reused without having
+/// to allocate memory again.
+///
+/// The I/O buffers of the generated collections are taken from and returned to
+/// the pool for their element type. In a typical read loop the buffers of one
+/// Frame are returned when it is destroyed and then reused for the next Frame,
+/// such that almost no allocations are necessary once the buffers have grown
+/// to their steady state size.
+///
+/// The pool keeps at most maxSize vectors, and at most maxBytes of memory in
+/// total. Vectors that have grown beyond maxVectorBytes (e.g. for one unusually
+/// large event) are not kept either. All vectors beyond these limits are simply
+/// deleted when they are released. trim and clear can be used to give back the
+/// memory that is kept by the pool.
+template <typename T>
+class VectorPool {
+public:
+  using VecPtr = std::unique_ptr<std::vector<T>>;
+
+  /// The default maximum number of vectors that are kept in the pool
+  static constexpr size_t defaultMaxSize = 128;
+  /// The default maximum capacity (in bytes) of a vector that is kept
+  static constexpr size_t defaultMaxVectorBytes = size_t{16} * 1024 * 1024;
+  /// The default maximum number of bytes that are kept in the pool in total
+  static constexpr size_t defaultMaxBytes = size_t{64} * 1024 * 1024;
+
+  /// Get the pool instance for this type
+  static VectorPool& instance() {
+    // Intentionally never destroyed, to make it possible to release vectors
+    // from the destructors of other static objects
+    static auto* pool = new VectorPool();
+    return *pool;
+  }
+
+  VectorPool(const VectorPool&) = delete;
+  VectorPool& operator=(const VectorPool&) = delete;
+  VectorPool(VectorPool&&) = delete;
+  VectorPool& operator=(VectorPool&&) = delete;
+  ~VectorPool() = default;
+
+  /// Get an empty vector, which potentially already has some capacity
+  VecPtr acquire() {
+    {
+      std::lock_guard lock{m_mtx};
+      if (!m_vectors.empty()) {
+        auto vec = std::move(m_vectors.back());
+        m_vectors.pop_back();
+        m_retainedBytes -= capacityBytes(*vec);
+        return vec;
+      }
+    }
+    return std::make_unique<std::vector<T>>();
+  }
+
+  /// Return a vector to the pool for later reuse. Its contents are cleared,
+  /// but it keeps its capacity. If the pool is full, or if the vector is too
+  /// large, the vector is deleted
+  void release(VecPtr vec) {
+    if (!vec) {
+      return;
+    }
+    vec->clear();
+    const auto bytes = capacityBytes(*vec);
+    std::lock_guard lock{m_mtx};
+    if (m_vectors.size() < m_maxSize && bytes <= m_maxVectorBytes && m_retainedBytes + bytes <= m_maxBytes) {
+      m_retainedBytes += bytes;
+      m_vectors.emplace_back(std::move(vec));
+    }
+  }
+
+  /// Set the maximum number of vectors that are kept in the pool. 0 disables
+  /// the pooling
+  void setMaxSize(size_t maxSize) {
+    std::lock_guard lock{m_mtx};
+    m_maxSize = maxSize;
+    while (m_vectors.size() > maxSize) {
+      dropLargest();
+    }
+  }
+
+  /// Set the maximum capacity (in bytes) of a vector for it to be kept in the
+  /// pool. Vectors that are already kept are deleted if they are larger
+  void setMaxVectorBytes(size_t maxVectorBytes) {
+    std::lock_guard lock{m_mtx};
+    m_maxVectorBytes = maxVectorBytes;
+    std::erase_if(m_vectors, [this](const auto& vec) {
+      const auto bytes = capacityBytes(*vec);
+      if (bytes > m_maxVectorBytes) {
+        m_retainedBytes -= bytes;
+        return true;
+      }
+      return false;
+    });
+  }
+
+  /// Set the maximum number of bytes that are kept in the pool in total
+  void setMaxBytes(size_t maxBytes) {
+    std::lock_guard lock{m_mtx};
+    m_maxBytes = maxBytes;
+    trimImpl(maxBytes);
+  }
+
+  /// Delete the largest vectors that are kept in the pool until at most
+  /// maxBytes are kept
+  void trim(size_t maxBytes = 0) {
+    std::lock_guard lock{m_mtx};
+    trimImpl(maxBytes);
+  }
+
+  /// Get the number of bytes that are currently kept in the pool
+  size_t retainedBytes() const {
+    std::lock_guard lock{m_mtx};
+    return m_retainedBytes;
+  }
+
+  /// Get the number of vectors that are currently available for reuse
+  size_t size() const {
+    std::lock_guard lock{m_mtx};
+    return m_vectors.size();
+  }
+
+  /// Delete all vectors that are currently kept in the pool
+  void clear() {
+    std::lock_guard lock{m_mtx};
+    m_vectors.clear();
+    m_retainedBytes = 0;
+  }
+
+private:
+  VectorPool() = default;
+
+  static size_t capacityBytes(const std::vector<T>& vec) {
+    return vec.capacity() * sizeof(T);
+  }
+
+  /// Delete the vector with the largest capacity. The pool must not be empty
+  /// and the mutex has to be held
+  void dropLargest() {
+    const auto it = std::ranges::max_element(m_vectors, {}, [](const auto& vec) { return vec->capacity(); });
+    m_retainedBytes -= capacityBytes(**it);
+    m_vectors.erase(it);
+  }
+
+  /// Delete vectors until at most maxBytes are kept. The mutex has to be held
+  void trimImpl(size_t maxBytes) {
+    while (m_retainedBytes > maxBytes) {
+      dropLargest();
+    }
+  }
+
+  mutable std::mutex m_mtx{};                     ///< Guards the stored vectors
+  std::vector<VecPtr> m_vectors{};                ///< The vectors that are available for reuse
+  size_t m_maxSize{defaultMaxSize};               ///< The maximum number of vectors to keep
+  size_t m_maxVectorBytes{defaultMaxVectorBytes}; ///< The maximum capacity of a vector that is kept
+  size_t m_maxBytes{defaultMaxBytes};             ///< The maximum number of bytes to keep in total
+  size_t m_retainedBytes{0};                      ///< The number of bytes that are currently kept
+};
+
+} // namespace podio::utils
+
+#endif // PODIO_UTILITIES_VECTORPOOL_H
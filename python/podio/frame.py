@@ -109,6 +109,44 @@ class Frame:
             raise KeyError(f"Collection '{name}' is not available")
         return collection
 
+    def getCollectionSize(self, name):
+        """Get the value type, the number of elements and the size of the buffers
+        of a collection, without unpacking it if the Frame has been read from a
+        file with a collection size index.
+
+        Args:
+            name (str): The name of the desired collection
+
+        Returns:
+            podio.CollectionSizeInfo: The size information with the valueType,
+                elements and bytes of the collection. The bytes are an empty
+                optional if the Frame has no collection size index for it
+
+        Raises:
+            KeyError: If the collection with the name is not available
+        """
+        size_info = self._frame.getCollectionSize(name)
+        if not size_info.has_value():
+            raise KeyError(f"Collection '{name}' is not available")
+        return size_info.value()
+
+    def getCollectionID(self, name):
+        """Get the collection ID of a collection without unpacking it
+
+        Args:
+            name (str): The name of the desired collection
+
+        Returns:
+            int: The collection ID of the collection
+
+        Raises:
+            KeyError: If no collection with the name is known to the Frame
+        """
+        coll_id = self._frame.getCollectionIDTableForWrite().collectionID(name)
+        if not coll_id.has_value():
+            raise KeyError(f"Collection '{name}' is not available")
+        return coll_id.value()
+
     def getName(self, token):
         """Get the name of the collection from the Frame
 
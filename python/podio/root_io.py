@@ -67,26 +67,34 @@ class LegacyReader(BaseReaderMixin):
 class Writer(BaseWriterMixin):
     """Writer class for writing podio root files"""
 
-    def __init__(self, filename):
+    def __init__(self, filename, options=None):
         """Create a writer for writing files
 
         Args:
             filename (str or Path): The name of the output file
+            options (podio.WriterOptions, optional): The options for writing,
+                e.g. the compression settings
         """
         filename = convert_to_str_paths(filename)[0]
-        self._writer = podio.ROOTWriter(filename)
+        if options is None:
+            options = podio.WriterOptions()
+        self._writer = podio.ROOTWriter(filename, options)
         super().__init__()
 
 
 class RNTupleWriter(BaseWriterMixin):
     """Writer class for writing podio root files"""
 
-    def __init__(self, filename):
+    def __init__(self, filename, options=None):
         """Create a writer for writing files
 
         Args:
             filename (str or Path): The name of the output file
+            options (podio.WriterOptions, optional): The options for writing,
+                e.g. the compression settings
         """
         filename = convert_to_str_paths(filename)[0]
-        self._writer = podio.RNTupleWriter(filename)
+        if options is None:
+            options = podio.WriterOptions()
+        self._writer = podio.RNTupleWriter(filename, options)
         super().__init__()
@@ -17,15 +17,15 @@ from podio.utils import convert_to_str_paths  # pylint: disable=wrong-import-pos
 class Reader(BaseReaderMixin):
     """Reader class for reading podio SIO files."""
 
-    def __init__(self, filename):
-        """Create a reader that reads from the passed file.
+    def __init__(self, filenames):
+        """Create a reader that reads from the passed file(s).
 
         Args:
-            filename (str or Path): File to open and read data from.
+            filenames (str or list[str] or Path or list[Path]): file(s) to open and read data from
         """
-        filename = convert_to_str_paths(filename)[0]
+        filenames = convert_to_str_paths(filenames)
         self._reader = podio.SIOReader()
-        self._reader.openFile(filename)
+        self._reader.openFiles(filenames)
 
         super().__init__()
 
@@ -54,13 +54,17 @@ class LegacyReader(BaseReaderMixin):
 class Writer(BaseWriterMixin):
     """Writer class for writing podio root files."""
 
-    def __init__(self, filename):
+    def __init__(self, filename, options=None):
         """Create a writer for writing files.
 
         Args:
             filename (str or Path): The name of the output file.
+            options (podio.WriterOptions, optional): The options for writing,
+                e.g. the compression settings.
         """
         filename = convert_to_str_paths(filename)[0]
-        self._writer = podio.SIOWriter(filename)
+        if options is None:
+            options = podio.WriterOptions()
+        self._writer = podio.SIOWriter(filename, options)
 
         super().__init__()
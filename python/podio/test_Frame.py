@@ -107,6 +107,12 @@ class FrameTest(unittest.TestCase):
         # On the other hand the return value of put has the original content
         self.assertEqual(len(hits2), 1)
 
+        size_info = frame.getCollectionSize("hits_from_python")
+        self.assertEqual(size_info.valueType, "ExampleHit")
+        self.assertEqual(size_info.elements, 1)
+        with self.assertRaises(KeyError):
+            _ = frame.getCollectionSize("NonExistantCollection")
+
     def test_frame_put_parameters(self):
         """Check that putting a parameter works as expected"""
         frame = Frame()
@@ -264,6 +264,14 @@ class CPPClassGenerator(ClassGeneratorBaseMixin):
             includes.add("#include <vector>")
             includes.add('#include "podio/RelationRange.h"')
 
+        # The names of the multi relations that are kept as ObjectIDs for read
+        # objects, and which hence use different iterators
+        datatype["lazy_relations"] = []
+        if self._uses_lazy_multi_relations(datatype["class"].full_type):
+            datatype["lazy_relations"] = [rel.name for rel in datatype["OneToManyRelations"]]
+        if datatype["lazy_relations"]:
+            includes.add('#include "podio/detail/RelationTable.h"')
+
         for relation in datatype["OneToManyRelations"]:
             if self._is_interface(relation.full_type):
                 relation.interface_types = self.datamodel.interfaces[relation.full_type]["Types"]
@@ -327,6 +335,12 @@ class CPPClassGenerator(ClassGeneratorBaseMixin):
             or datatype["OneToOneRelations"]
         )
         datatype["is_trivial_type"] = not non_trivial_type
+        datatype["contiguous_storage"] = self._uses_contiguous_storage(
+            datatype["class"].full_type
+        )
+        datatype["inline_single_relations"] = self._uses_inline_single_relations(
+            datatype["class"].full_type
+        )
 
     def _preprocess_for_collection(self, datatype):
         """Do the necessary preprocessing for the collection"""
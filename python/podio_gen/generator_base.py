@@ -302,3 +302,24 @@ class ClassGeneratorBaseMixin:
         if self.upstream_edm:
             all_interfaces = list(self.datamodel.interfaces) + list(self.upstream_edm.interfaces)
         return classname in all_interfaces
+
+    def _is_enabled_for(self, option, classname):
+        """Check whether an option that is either a bool or a list of datatypes
+        is switched on for this datatype"""
+        value = self.datamodel.options[option]
+        if isinstance(value, bool):
+            return value
+        return classname in value
+
+    def _uses_contiguous_storage(self, classname):
+        """Check whether the collection of this datatype stores its Objs contiguously"""
+        return self._is_enabled_for("contiguousStorage", classname)
+
+    def _uses_inline_single_relations(self, classname):
+        """Check whether the Objs of this datatype store their single relations inline"""
+        return self._is_enabled_for("inlineSingleRelations", classname)
+
+    def _uses_lazy_multi_relations(self, classname):
+        """Check whether the collections of this datatype keep the multi relations
+        of read objects as ObjectIDs"""
+        return self._is_enabled_for("lazyMultiRelations", classname)
@@ -314,6 +314,12 @@ class DataModel:  # pylint: disable=too-few-public-methods
             "exposePODMembers": True,
             # use subfolder when including package header files
             "includeSubfolder": False,
+            # should collections store their Objs contiguously?
+            "contiguousStorage": False,
+            # should single relations be stored inline in the Objs?
+            "inlineSingleRelations": False,
+            # should the multi relations of read objects be kept as ObjectIDs?
+            "lazyMultiRelations": False,
         }
         self.schema_version = schema_version
         self.components = components or {}
@@ -190,6 +190,7 @@ class ClassDefinitionValidator:
         cls._check_datatypes(datamodel, expose_pod_members, upstream_edm)
         cls._check_interfaces(datamodel, upstream_edm)
         cls._check_links(datamodel, upstream_edm)
+        cls._check_datatype_list_options(datamodel)
 
     @classmethod
     def _check_comp(cls, member, components, upstream_edm):
@@ -363,6 +364,27 @@ class ClassDefinitionValidator:
                     f"'{classname}' declares a invalid vector member of type '{vecmem.full_type}'"
                 )
 
+    @classmethod
+    def _check_datatype_list_options(cls, datamodel):
+        """Check that the options that can be switched on per datatype are either
+        a bool or a list of datatypes that are defined in this datamodel"""
+        for option in ("contiguousStorage", "inlineSingleRelations", "lazyMultiRelations"):
+            value = datamodel.options.get(option, False)
+            if isinstance(value, bool):
+                continue
+
+            if not isinstance(value, list):
+                raise DefinitionError(
+                    f"'{option}' option has to be either a bool or a list of datatypes"
+                )
+
+            for name in value:
+                if name not in datamodel.datatypes:
+                    raise DefinitionError(
+                        f"'{option}' option uses '{name}' which is not a datatype "
+                        "of this datamodel"
+                    )
+
     @classmethod
     def _check_keys(cls, classname, definition):
         """Check the keys of a datatype."""
@@ -463,6 +485,15 @@ class PodioConfigReader:
         "exposePODMembers": True,
         # use subfolder when including package header files
         "includeSubfolder": False,
+        # should collections store their Objs contiguously? (True, False or a
+        # list of datatypes)
+        "contiguousStorage": False,
+        # should single relations be stored inline in the Objs? (True, False or
+        # a list of datatypes)
+        "inlineSingleRelations": False,
+        # should the multi relations of read objects be kept as ObjectIDs? (True,
+        # False or a list of datatypes)
+        "lazyMultiRelations": False,
     }
 
     @staticmethod
@@ -693,6 +693,32 @@ class ClassDefinitionValidatorTest(unittest.TestCase):  # pylint: disable=too-ma
             upstream_dm,
         )
 
+    def test_datatype_list_options(self):
+        """Check that the options that can be switched on per datatype can only be
+        a bool or a list of datatypes from the datamodel"""
+        for option in ("contiguousStorage", "inlineSingleRelations", "lazyMultiRelations"):
+            for value in (True, False, ["DataType"]):
+                self._assert_no_exception(
+                    DefinitionError,
+                    f"{{}} should allow valid {option} options",
+                    self.validate,
+                    make_dm(
+                        {},
+                        self.valid_datatype,
+                        options={"exposePODMembers": False, option: value},
+                    ),
+                )
+
+            for value in ("DataType", ["NotADataType"]):
+                with self.assertRaises(DefinitionError):
+                    self.validate(
+                        make_dm(
+                            {},
+                            self.valid_datatype,
+                            options={"exposePODMembers": False, option: value},
+                        )
+                    )
+
 
 if __name__ == "__main__":
     unittest.main()
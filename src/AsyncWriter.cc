@@ -0,0 +1,154 @@
+#include "podio/AsyncWriter.h"
+
+#include "TROOT.h"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+namespace podio {
+
+AsyncWriter::AsyncWriter(podio::Writer writer, size_t queueSize) :
+    m_writer(std::move(writer)), m_queueSize(std::max<size_t>(queueSize, 1)) {
+  // Files can be written on the I/O thread while others are read or written on
+  // the calling thread at the same time
+  ROOT::EnableThreadSafety();
+  m_thread = std::thread([this]() { run(); });
+}
+
+AsyncWriter::~AsyncWriter() {
+  if (!m_finished) {
+    try {
+      finish();
+    } catch (const std::exception& ex) {
+      std::cerr << "Error while writing Frames asynchronously: " << ex.what() << std::endl;
+    }
+  }
+}
+
+void AsyncWriter::writeFrame(podio::Frame&& frame, const std::string& category) {
+  const auto collsToWrite = frame.getAvailableCollections();
+  writeFrame(std::move(frame), category, collsToWrite);
+}
+
+void AsyncWriter::writeFrame(podio::Frame&& frame, const std::string& category,
+                             const std::vector<std::string>& collsToWrite) {
+  std::unique_lock lock{m_mtx};
+  rethrowError();
+  checkNotFinished();
+
+  if (m_queue.size() >= m_queueSize) {
+    m_stats.nWaits++;
+    m_cv.wait(lock, [this]() { return m_queue.size() < m_queueSize || m_error; });
+    rethrowError();
+  }
+
+  m_queue.emplace_back(std::move(frame), category, collsToWrite);
+  m_stats.maxQueueDepth = std::max(m_stats.maxQueueDepth, m_queue.size());
+  lock.unlock();
+  m_cv.notify_all();
+}
+
+void AsyncWriter::writeFrame(const podio::Frame& frame, const std::string& category) {
+  writeFrame(frame, category, frame.getAvailableCollections());
+}
+
+void AsyncWriter::writeFrame(const podio::Frame& frame, const std::string& category,
+                             const std::vector<std::string>& collsToWrite) {
+  std::unique_lock lock{m_mtx};
+  waitForDrain(lock);
+  rethrowError();
+  checkNotFinished();
+
+  // The I/O thread is idle and only we can queue new Frames, so it is safe to
+  // use the writer directly here
+  m_writer.writeFrame(frame, category, collsToWrite);
+  m_stats.nWritten++;
+}
+
+void AsyncWriter::finish() {
+  {
+    std::unique_lock lock{m_mtx};
+    if (m_finished) {
+      return;
+    }
+    m_finished = true;
+    waitForDrain(lock);
+    m_stop = true;
+  }
+  m_cv.notify_all();
+  if (m_thread.joinable()) {
+    m_thread.join();
+  }
+
+  // Finish the file also in case of errors, to keep at least what has been
+  // successfully written so far
+  m_writer.finish();
+  rethrowError();
+}
+
+AsyncWriterStatistics AsyncWriter::getStatistics() const {
+  std::lock_guard lock{m_mtx};
+  return m_stats;
+}
+
+void AsyncWriter::run() {
+  std::unique_lock lock{m_mtx};
+  while (true) {
+    m_cv.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+    if (m_queue.empty()) {
+      return;
+    }
+
+    std::exception_ptr error{nullptr};
+    {
+      auto next = std::move(m_queue.front());
+      m_queue.pop_front();
+      m_busy = true;
+      lock.unlock();
+      m_cv.notify_all();
+
+      try {
+        m_writer.writeFrame(next.frame, next.category, next.collsToWrite);
+      } catch (...) {
+        error = std::current_exception();
+      }
+      // The Frame is destroyed here, i.e. outside of the lock
+    }
+
+    lock.lock();
+    m_busy = false;
+    if (error) {
+      m_error = error;
+      m_queue.clear();
+    } else {
+      m_stats.nWritten++;
+    }
+    m_cv.notify_all();
+  }
+}
+
+void AsyncWriter::waitForDrain(std::unique_lock<std::mutex>& lock) {
+  m_cv.wait(lock, [this]() { return m_queue.empty() && !m_busy; });
+}
+
+void AsyncWriter::rethrowError() {
+  if (m_error) {
+    auto error = std::exchange(m_error, nullptr);
+    std::rethrow_exception(error);
+  }
+}
+
+void AsyncWriter::checkNotFinished() const {
+  if (m_finished) {
+    throw std::runtime_error("Cannot write Frames with an AsyncWriter that has already been finished");
+  }
+}
+
+Writer makeAsyncWriter(const std::string& filename, const std::string& type, const WriterOptions& options,
+                       size_t queueSize) {
+  return Writer{std::make_unique<AsyncWriter>(makeWriter(filename, type, options), queueSize)};
+}
+
+} // namespace podio
@@ -8,39 +8,78 @@
 
 namespace podio {
 
-CollectionIDTable::CollectionIDTable() : m_mutex(std::make_unique<std::mutex>()) {
+namespace {
+  /// Look up a key in the (optional) shared and the local index map
+  template <typename KeyT, typename MapT>
+  std::optional<size_t> lookup(const MapT* sharedMap, const MapT& map, const KeyT& key) {
+    if (sharedMap) {
+      if (const auto it = sharedMap->find(key); it != sharedMap->end()) {
+        return it->second;
+      }
+    }
+    if (const auto it = map.find(key); it != map.end()) {
+      return it->second;
+    }
+    return std::nullopt;
+  }
+} // namespace
+
+CollectionIDTable::CollectionIDTable() : m_mutex(std::make_unique<std::shared_mutex>()) {
 }
 
 CollectionIDTable::CollectionIDTable(std::vector<uint32_t>&& ids, std::vector<std::string>&& names) :
-    m_collectionIDs(std::move(ids)), m_names(std::move(names)), m_mutex(std::make_unique<std::mutex>()) {
+    m_collectionIDs(std::move(ids)), m_names(std::move(names)), m_mutex(std::make_unique<std::shared_mutex>()) {
+  completeIndex();
 }
 
 CollectionIDTable::CollectionIDTable(const std::vector<uint32_t>& ids, const std::vector<std::string>& names) :
-    m_collectionIDs(ids), m_names(names), m_mutex(std::make_unique<std::mutex>()) {
+    m_collectionIDs(ids), m_names(names), m_mutex(std::make_unique<std::shared_mutex>()) {
+  completeIndex();
+}
+
+std::shared_ptr<const CollectionIDTable> CollectionIDTable::makeImmutable(std::vector<uint32_t>&& ids,
+                                                                          std::vector<std::string>&& names) {
+  auto table = std::make_shared<CollectionIDTable>(std::move(ids), std::move(names));
+  table->m_sharedIndex = std::make_shared<const Index>(std::move(table->m_index));
+  table->m_index = Index{};
+  table->m_immutable = true;
+  return table;
+}
+
+CollectionIDTable CollectionIDTable::copy() const {
+  const auto lock = readLock();
+  auto table = CollectionIDTable();
+  table.m_collectionIDs = m_collectionIDs;
+  table.m_names = m_names;
+  table.m_sharedIndex = m_sharedIndex;
+  table.m_index = m_index;
+  table.m_nIndexed = m_nIndexed;
+  return table;
 }
 
 std::optional<const std::string> CollectionIDTable::name(uint32_t ID) const {
-  std::lock_guard<std::mutex> lock{*m_mutex};
-  const auto result = std::ranges::find(m_collectionIDs, ID);
-  const auto index = std::distance(m_collectionIDs.begin(), result);
-  if (index >= static_cast<ptrdiff_t>(m_names.size())) {
-    return std::nullopt;
+  const auto lock = readLock();
+  if (const auto index = find(ID)) {
+    return m_names[index.value()];
   }
-  return m_names[index];
+  return std::nullopt;
 }
 
 std::optional<uint32_t> CollectionIDTable::collectionID(const std::string& name) const {
-  std::lock_guard<std::mutex> lock{*m_mutex};
-  const auto result = std::ranges::find(m_names, name);
-  const auto index = std::distance(m_names.begin(), result);
-  if (index >= static_cast<ptrdiff_t>(m_collectionIDs.size())) {
-    return std::nullopt;
+  const auto lock = readLock();
+  if (const auto index = find(name)) {
+    return m_collectionIDs[index.value()];
   }
-  return m_collectionIDs[index];
+  return std::nullopt;
+}
+
+std::optional<size_t> CollectionIDTable::index(const std::string& name) const {
+  const auto lock = readLock();
+  return find(name);
 }
 
 void CollectionIDTable::print() const {
-  std::lock_guard<std::mutex> lock{*m_mutex};
+  const auto lock = readLock();
   std::cout << "CollectionIDTable" << std::endl;
   for (unsigned i = 0; i < m_names.size(); ++i) {
     std::cout << "\t" << m_names[i] << " : " << m_collectionIDs[i] << std::endl;
@@ -56,18 +95,57 @@ bool CollectionIDTable::present(uint32_t collectionID) const {
 }
 
 uint32_t CollectionIDTable::add(const std::string& name) {
-  std::lock_guard<std::mutex> lock{*m_mutex};
-  const auto result = std::ranges::find(m_names, name);
-  uint32_t ID = 0;
-  if (result == m_names.end()) {
-    m_names.emplace_back(name);
-    MurmurHash3_x86_32(name.c_str(), name.size(), 0, &ID);
-    m_collectionIDs.emplace_back(ID);
-  } else {
-    const auto index = std::distance(m_names.begin(), result);
-    ID = m_collectionIDs[index];
+  std::lock_guard lock{*m_mutex};
+  completeIndex();
+  if (const auto index = find(name)) {
+    return m_collectionIDs[index.value()];
   }
+
+  uint32_t ID = 0;
+  MurmurHash3_x86_32(name.c_str(), name.size(), 0, &ID);
+  m_names.emplace_back(name);
+  m_collectionIDs.emplace_back(ID);
+  addToIndex(m_names.size() - 1);
   return ID;
 }
 
+void CollectionIDTable::addToIndex(size_t index) const {
+  // emplace does not overwrite existing entries, so for duplicates the first
+  // one wins, which is the same behavior as a linear search
+  m_index.ids.emplace(m_collectionIDs[index], index);
+  m_index.names.emplace(m_names[index], index);
+  m_nIndexed = index + 1;
+}
+
+void CollectionIDTable::completeIndex() const {
+  for (auto i = m_nIndexed; i < std::min(m_names.size(), m_collectionIDs.size()); ++i) {
+    addToIndex(i);
+  }
+}
+
+std::optional<size_t> CollectionIDTable::find(uint32_t collectionID) const {
+  return lookup(m_sharedIndex ? &m_sharedIndex->ids : nullptr, m_index.ids, collectionID);
+}
+
+std::optional<size_t> CollectionIDTable::find(const std::string& name) const {
+  return lookup(m_sharedIndex ? &m_sharedIndex->names : nullptr, m_index.names, name);
+}
+
+std::shared_lock<std::shared_mutex> CollectionIDTable::readLock() const {
+  if (m_immutable) {
+    return {};
+  }
+  auto lock = std::shared_lock{*m_mutex};
+  if (!indexComplete()) {
+    // Tables that have been read via ROOT I/O start without an index
+    lock.unlock();
+    {
+      std::lock_guard writeLock{*m_mutex};
+      completeIndex();
+    }
+    lock.lock();
+  }
+  return lock;
+}
+
 } // namespace podio
@@ -4,31 +4,52 @@
 
 namespace podio {
 
-GenericParameters::GenericParameters() :
-    m_intMtx(std::make_unique<std::mutex>()),
-    m_floatMtx(std::make_unique<std::mutex>()),
-    m_stringMtx(std::make_unique<std::mutex>()),
-    m_doubleMtx(std::make_unique<std::mutex>()) {
+GenericParameters::GenericParameters() : m_mtx(std::make_unique<std::shared_mutex>()) {
 }
 
-GenericParameters::GenericParameters(const GenericParameters& other) :
-    m_intMtx(std::make_unique<std::mutex>()),
-    m_floatMtx(std::make_unique<std::mutex>()),
-    m_stringMtx(std::make_unique<std::mutex>()),
-    m_doubleMtx(std::make_unique<std::mutex>()) {
-  {
-    // acquire all locks at once to make sure all internal maps are
-    // copied at the same "state" of the GenericParameters
-    auto& intMtx = other.getMutex<int>();
-    auto& floatMtx = other.getMutex<float>();
-    auto& stringMtx = other.getMutex<std::string>();
-    auto& doubleMtx = other.getMutex<double>();
-    std::scoped_lock lock(intMtx, floatMtx, stringMtx, doubleMtx);
-    _intMap = other._intMap;
-    _floatMap = other._floatMap;
-    _stringMap = other._stringMap;
-    _doubleMap = other._doubleMap;
+GenericParameters::GenericParameters(const GenericParameters& other) : m_mtx(std::make_unique<std::shared_mutex>()) {
+  // lock once to make sure all internal storages are copied at the same
+  // "state" of the GenericParameters
+  const auto lock = other.readLock();
+  m_intParams = other.m_intParams;
+  m_floatParams = other.m_floatParams;
+  m_stringParams = other.m_stringParams;
+  m_doubleParams = other.m_doubleParams;
+}
+
+GenericParameters::GenericParameters(GenericParameters&& other) :
+    m_intParams(std::move(other.m_intParams)),
+    m_floatParams(std::move(other.m_floatParams)),
+    m_stringParams(std::move(other.m_stringParams)),
+    m_doubleParams(std::move(other.m_doubleParams)),
+    m_mtx(std::move(other.m_mtx)) {
+  other.reset();
+}
+
+GenericParameters& GenericParameters::operator=(GenericParameters&& other) {
+  if (this != &other) {
+    m_intParams = std::move(other.m_intParams);
+    m_floatParams = std::move(other.m_floatParams);
+    m_stringParams = std::move(other.m_stringParams);
+    m_doubleParams = std::move(other.m_doubleParams);
+    m_mtx = std::move(other.m_mtx);
+    other.reset();
   }
+  return *this;
+}
+
+void GenericParameters::reset() {
+  m_intParams.clear();
+  m_floatParams.clear();
+  m_stringParams.clear();
+  m_doubleParams.clear();
+  m_mtx = std::make_unique<std::shared_mutex>();
+}
+
+GenericParameters GenericParameters::snapshot() const {
+  auto params = GenericParameters(*this);
+  params.m_mtx.reset();
+  return params;
 }
 
 template <typename T>
@@ -44,28 +65,29 @@ std::ostream& operator<<(std::ostream& os, const std::vector<T>& values) {
   return os << "]";
 }
 
-template <typename MapType>
-void printMap(const MapType& map, std::ostream& os) {
+template <typename StorageT>
+void printStorage(const StorageT& storage, std::ostream& os) {
   const auto osflags = os.flags();
   os << std::left << std::setw(30) << "Key "
      << "Value " << '\n';
   os << "--------------------------------------------------------------------------------\n";
-  for (const auto& [key, value] : map) {
-    os << std::left << std::setw(30) << key << value << '\n';
+  for (size_t i = 0; i < storage.size(); ++i) {
+    os << std::left << std::setw(30) << storage.keys[i] << storage.values[i] << '\n';
   }
 
   os.flags(osflags);
 }
 
 void GenericParameters::print(std::ostream& os, bool flush) const {
+  const auto lock = readLock();
   os << "int parameters\n\n";
-  printMap(getMap<int>(), os);
+  printStorage(getStorage<int>(), os);
   os << "\nfloat parameters\n";
-  printMap(getMap<float>(), os);
+  printStorage(getStorage<float>(), os);
   os << "\ndouble parameters\n";
-  printMap(getMap<double>(), os);
+  printStorage(getStorage<double>(), os);
   os << "\nstd::string parameters\n";
-  printMap(getMap<std::string>(), os);
+  printStorage(getStorage<std::string>(), os);
 
   if (flush) {
     os.flush();
@@ -22,23 +22,9 @@ using ROOT::Experimental::RException;
 namespace podio {
 
 template <typename T>
-void RNTupleReader::readParams(const std::string& name, unsigned localEntry, unsigned readerIndex,
-                               GenericParameters& params) {
-  auto keyView = m_readers[name][readerIndex]->GetView<std::vector<std::string>>(root_utils::getGPKeyName<T>());
-  auto valueView = m_readers[name][readerIndex]->GetView<std::vector<std::vector<T>>>(root_utils::getGPValueName<T>());
-
-  params.loadFrom(keyView(localEntry), valueView(localEntry));
-}
-
-GenericParameters RNTupleReader::readEventMetaData(const std::string& name, unsigned localEntry, unsigned readerIndex) {
-  GenericParameters params;
-
-  readParams<int>(name, localEntry, readerIndex, params);
-  readParams<float>(name, localEntry, readerIndex, params);
-  readParams<double>(name, localEntry, readerIndex, params);
-  readParams<std::string>(name, localEntry, readerIndex, params);
-
-  return params;
+void RNTupleReader::bindParams(ROOT::Experimental::REntry& entry, GenericParameters::Storage<T>& storage) {
+  entry.BindRawPtr(root_utils::getGPKeyName<T>(), &storage.keys);
+  entry.BindRawPtr(root_utils::getGPValueName<T>(), &storage.values);
 }
 
 bool RNTupleReader::initCategory(const std::string& category) {
@@ -61,6 +47,14 @@ bool RNTupleReader::initCategory(const std::string& category) {
       m_metadata_readers[filename]->GetView<std::vector<std::string>>(root_utils::collInfoName(category));
   collInfo.type = collectionType(0);
 
+  try {
+    auto valueType =
+        m_metadata_readers[filename]->GetView<std::vector<std::string>>(root_utils::valueTypesName(category));
+    collInfo.valueType = valueType(0);
+  } catch (const RException&) {
+    // Files written with older versions of podio have no collection size index
+  }
+
   auto subsetCollection =
       m_metadata_readers[filename]->GetView<std::vector<short>>(root_utils::subsetCollection(category));
   collInfo.isSubsetCollection = subsetCollection(0);
@@ -68,7 +62,7 @@ bool RNTupleReader::initCategory(const std::string& category) {
   auto schemaVersion = m_metadata_readers[filename]->GetView<std::vector<SchemaVersionT>>("schemaVersion_" + category);
   collInfo.schemaVersion = schemaVersion(0);
 
-  m_idTables[category] = std::make_shared<CollectionIDTable>(collInfo.id, collInfo.name);
+  m_idTables[category] = CollectionIDTable::makeImmutable(std::vector(collInfo.id), std::vector(collInfo.name));
 
   return true;
 }
@@ -178,10 +172,9 @@ std::unique_ptr<ROOTFrameData> RNTupleReader::readEntry(const std::string& categ
   auto readerIndex = upper - 1 - m_readerEntries[category].begin();
 
   ROOTFrameData::BufferMap buffers;
-  // We need to create a non-bare entry here, because the entries for the
-  // parameters are not explicitly (re)set and we need them default initialized.
-  // In principle we would only need a bare entry for the collection data, since
-  // we set all the fields there in any case.
+  // We need to create a non-bare entry here, because the fields of the
+  // collections that are not read are not bound and we need them default
+  // initialized.
   auto dentry = m_readers[category][readerIndex]->GetModel().CreateEntry();
 
   for (size_t i = 0; i < collInfo.id.size(); ++i) {
@@ -202,19 +195,15 @@ std::unique_ptr<ROOTFrameData> RNTupleReader::readEntry(const std::string& categ
 
     if (collInfo.isSubsetCollection[i]) {
       auto brName = root_utils::subsetBranch(collInfo.name[i]);
-      auto vec = new std::vector<podio::ObjectID>;
-      dentry->BindRawPtr(brName, vec);
-      collBuffers.references->at(0) = std::unique_ptr<std::vector<podio::ObjectID>>(vec);
+      dentry->BindRawPtr(brName, collBuffers.references->at(0).get());
     } else {
       dentry->BindRawPtr(collInfo.name[i], collBuffers.data);
 
       const auto relVecNames = podio::DatamodelRegistry::instance().getRelationNames(collType);
       for (size_t j = 0; j < relVecNames.relations.size(); ++j) {
         const auto relName = relVecNames.relations[j];
-        auto vec = new std::vector<podio::ObjectID>;
         const auto brName = root_utils::refBranch(collInfo.name[i], relName);
-        dentry->BindRawPtr(brName, vec);
-        collBuffers.references->at(j) = std::unique_ptr<std::vector<podio::ObjectID>>(vec);
+        dentry->BindRawPtr(brName, collBuffers.references->at(j).get());
       }
 
       for (size_t j = 0; j < relVecNames.vectorMembers.size(); ++j) {
@@ -227,11 +216,87 @@ std::unique_ptr<ROOTFrameData> RNTupleReader::readEntry(const std::string& categ
     buffers.emplace(collInfo.name[i], std::move(collBuffers));
   }
 
+  // The parameters are read directly into the storage that is then taken over
+  // by the GenericParameters
+  GenericParameters::Storage<int> intParams;
+  GenericParameters::Storage<float> floatParams;
+  GenericParameters::Storage<double> doubleParams;
+  GenericParameters::Storage<std::string> stringParams;
+  bindParams(*dentry, intParams);
+  bindParams(*dentry, floatParams);
+  bindParams(*dentry, doubleParams);
+  bindParams(*dentry, stringParams);
+
+  // Files written with older versions of podio have no collection size index
+  std::vector<uint64_t> collElements;
+  std::vector<uint64_t> collBytes;
+  bool hasCollSizes = true;
+  try {
+    dentry->BindRawPtr(root_utils::collElementsName, &collElements);
+    dentry->BindRawPtr(root_utils::collBytesName, &collBytes);
+  } catch (const RException&) {
+    hasCollSizes = false;
+  }
+
   m_readers[category][readerIndex]->LoadEntry(localEntry, *dentry);
 
-  auto parameters = readEventMetaData(category, localEntry, readerIndex);
+  GenericParameters parameters;
+  parameters.loadFrom(std::move(intParams));
+  parameters.loadFrom(std::move(floatParams));
+  parameters.loadFrom(std::move(doubleParams));
+  parameters.loadFrom(std::move(stringParams));
 
-  return std::make_unique<ROOTFrameData>(std::move(buffers), m_idTables[category], std::move(parameters));
+  auto collSizes = hasCollSizes ? makeCollectionSizes(collInfo, collElements, collBytes, collsToRead)
+                                : podio::CollectionSizeIndex{};
+
+  return std::make_unique<ROOTFrameData>(std::move(buffers), m_idTables[category], std::move(parameters),
+                                         std::move(collSizes));
+}
+
+std::optional<podio::CollectionSizeIndex> RNTupleReader::getCollectionSizes(const std::string& category,
+                                                                             const unsigned entNum) {
+  if (m_totalEntries.find(category) == m_totalEntries.end()) {
+    getEntries(category);
+  }
+  if (entNum >= m_totalEntries[category]) {
+    return std::nullopt;
+  }
+  if (m_collectionInfo.find(category) == m_collectionInfo.end()) {
+    if (!initCategory(category)) {
+      return std::nullopt;
+    }
+  }
+
+  auto upper = std::ranges::upper_bound(m_readerEntries[category], entNum);
+  auto localEntry = entNum - *(upper - 1);
+  auto readerIndex = upper - 1 - m_readerEntries[category].begin();
+  auto& reader = m_readers[category][readerIndex];
+
+  try {
+    auto elementsView = reader->GetView<std::vector<uint64_t>>(root_utils::collElementsName);
+    auto bytesView = reader->GetView<std::vector<uint64_t>>(root_utils::collBytesName);
+    return makeCollectionSizes(m_collectionInfo[category], elementsView(localEntry), bytesView(localEntry), {});
+  } catch (const RException&) {
+    return std::nullopt;
+  }
+}
+
+podio::CollectionSizeIndex RNTupleReader::makeCollectionSizes(const CollectionInfo& collInfo,
+                                                              const std::vector<uint64_t>& elements,
+                                                              const std::vector<uint64_t>& bytes,
+                                                              const std::vector<std::string>& collsToRead) {
+  podio::CollectionSizeIndex collSizes{};
+  const auto nColls = collInfo.name.size();
+  if (elements.size() != nColls || bytes.size() != nColls || collInfo.valueType.size() != nColls) {
+    return collSizes;
+  }
+  for (size_t i = 0; i < collInfo.name.size(); ++i) {
+    if (!collsToRead.empty() && std::ranges::find(collsToRead, collInfo.name[i]) == collsToRead.end()) {
+      continue;
+    }
+    collSizes.emplace(collInfo.name[i], CollectionSizeInfo{collInfo.valueType[i], elements[i], bytes[i]});
+  }
+  return collSizes;
 }
 
 } // namespace podio
@@ -11,8 +11,8 @@
 
 namespace podio {
 
-RNTupleWriter::RNTupleWriter(const std::string& filename) :
-    m_file(new TFile(filename.c_str(), "RECREATE", "data file")) {
+RNTupleWriter::RNTupleWriter(const std::string& filename, const WriterOptions& options) :
+    m_file(new TFile(filename.c_str(), "RECREATE", "data file")), m_options(options) {
 }
 
 RNTupleWriter::~RNTupleWriter() {
@@ -22,27 +22,12 @@ RNTupleWriter::~RNTupleWriter() {
 }
 
 template <typename T>
-root_utils::ParamStorage<T>& RNTupleWriter::getParamStorage(CategoryInfo& catInfo) {
-  if constexpr (std::is_same_v<T, int>) {
-    return catInfo.intParams;
-  } else if constexpr (std::is_same_v<T, float>) {
-    return catInfo.floatParams;
-  } else if constexpr (std::is_same_v<T, double>) {
-    return catInfo.doubleParams;
-  } else if constexpr (std::is_same_v<T, std::string>) {
-    return catInfo.stringParams;
-  } else {
-    throw std::runtime_error("Unknown type");
-  }
-}
-
-template <typename T>
-void RNTupleWriter::fillParams(const GenericParameters& params, CategoryInfo& catInfo,
-                               ROOT::Experimental::REntry* entry) {
-  auto& paramStorage = getParamStorage<T>(catInfo);
-  paramStorage = params.getKeysAndValues<T>();
-  entry->BindRawPtr(root_utils::getGPKeyName<T>(), &paramStorage.keys);
-  entry->BindRawPtr(root_utils::getGPValueName<T>(), &paramStorage.values);
+void RNTupleWriter::fillParams(const GenericParameters::LockedView& params, ROOT::Experimental::REntry* entry) {
+  // Filling only reads the bound values, so the storage of the parameters can
+  // be used without copying it first. The entry needs non-const pointers
+  auto& storage = const_cast<GenericParameters::Storage<T>&>(params.getStorage<T>());
+  entry->BindRawPtr(root_utils::getGPKeyName<T>(), &storage.keys);
+  entry->BindRawPtr(root_utils::getGPValueName<T>(), &storage.values);
 }
 
 void RNTupleWriter::writeFrame(const podio::Frame& frame, const std::string& category) {
@@ -79,11 +64,13 @@ void RNTupleWriter::writeFrame(const podio::Frame& frame, const std::string& cat
   if (new_category) {
     // Now we have enough info to populate the rest
     auto model = createModels(collections);
-    catInfo.writer = ROOT::Experimental::RNTupleWriter::Append(std::move(model), category, *m_file.get(), {});
+    catInfo.writer =
+        ROOT::Experimental::RNTupleWriter::Append(std::move(model), category, *m_file.get(), getWriteOptions(category));
 
     for (const auto& [name, coll] : collections) {
       catInfo.ids.emplace_back(coll->getID());
       catInfo.types.emplace_back(coll->getTypeName());
+      catInfo.valueTypes.emplace_back(coll->getValueTypeName());
       catInfo.subsetCollections.emplace_back(coll->isSubsetCollection());
       catInfo.schemaVersions.emplace_back(coll->getSchemaVersion());
     }
@@ -96,9 +83,6 @@ void RNTupleWriter::writeFrame(const podio::Frame& frame, const std::string& cat
 
   auto entry = m_categories[category].writer->GetModel().CreateBareEntry();
 
-  ROOT::Experimental::RNTupleWriteOptions options;
-  options.SetCompression(ROOT::RCompressionSetting::EDefaults::kUseGeneralPurpose);
-
   for (const auto& [name, coll] : collections) {
     auto collBuffers = coll->getBuffers();
     if (collBuffers.vecPtr) {
@@ -139,11 +123,21 @@ void RNTupleWriter::writeFrame(const podio::Frame& frame, const std::string& cat
     // &const_cast<podio::GenericParameters&>(frame.getParameters()));
   }
 
-  const auto& params = frame.getParameters();
-  fillParams<int>(params, catInfo, entry.get());
-  fillParams<float>(params, catInfo, entry.get());
-  fillParams<double>(params, catInfo, entry.get());
-  fillParams<std::string>(params, catInfo, entry.get());
+  // The parameters must not change until the entry has been filled
+  const auto params = frame.getParameters().lockedView();
+  fillParams<int>(params, entry.get());
+  fillParams<float>(params, entry.get());
+  fillParams<double>(params, entry.get());
+  fillParams<std::string>(params, entry.get());
+
+  catInfo.collElements.clear();
+  catInfo.collBytes.clear();
+  for (const auto& [_, coll] : collections) {
+    catInfo.collElements.push_back(coll->size());
+    catInfo.collBytes.push_back(coll->getBuffers().nBytes);
+  }
+  entry->BindRawPtr(root_utils::collElementsName, &catInfo.collElements);
+  entry->BindRawPtr(root_utils::collBytesName, &catInfo.collBytes);
 
   m_categories[category].writer->Fill(*entry);
 }
@@ -213,10 +207,21 @@ RNTupleWriter::createModels(const std::vector<root_utils::StoreCollection>& coll
   model->AddField(RFieldBase::Create(root_utils::doubleValueName, "std::vector<std::vector<double>>").Unwrap());
   model->AddField(RFieldBase::Create(root_utils::stringValueName, "std::vector<std::vector<std::string>>").Unwrap());
 
+  model->AddField(RFieldBase::Create(root_utils::collElementsName, "std::vector<std::uint64_t>").Unwrap());
+  model->AddField(RFieldBase::Create(root_utils::collBytesName, "std::vector<std::uint64_t>").Unwrap());
+
   model->Freeze();
   return model;
 }
 
+ROOT::Experimental::RNTupleWriteOptions RNTupleWriter::getWriteOptions(const std::string& category) const {
+  ROOT::Experimental::RNTupleWriteOptions options;
+  if (const auto settings = root_utils::getCompressionSettings(m_options.getCompression(category))) {
+    options.SetCompression(settings.value());
+  }
+  return options;
+}
+
 RNTupleWriter::CategoryInfo& RNTupleWriter::getCategoryInfo(const std::string& category) {
   if (auto it = m_categories.find(category); it != m_categories.end()) {
     return it->second;
@@ -257,6 +262,8 @@ void RNTupleWriter::finish() {
     *collectionNameField = collInfo.names;
     auto collectionTypeField = metadata->MakeField<std::vector<std::string>>({root_utils::collInfoName(category)});
     *collectionTypeField = collInfo.types;
+    auto valueTypeField = metadata->MakeField<std::vector<std::string>>({root_utils::valueTypesName(category)});
+    *valueTypeField = collInfo.valueTypes;
     auto subsetCollectionField = metadata->MakeField<std::vector<short>>({root_utils::subsetCollection(category)});
     *subsetCollectionField = collInfo.subsetCollections;
     auto schemaVersionField = metadata->MakeField<std::vector<SchemaVersionT>>({"schemaVersion_" + category});
@@ -264,8 +271,8 @@ void RNTupleWriter::finish() {
   }
 
   metadata->Freeze();
-  auto metadataWriter =
-      ROOT::Experimental::RNTupleWriter::Append(std::move(metadata), root_utils::metaTreeName, *m_file, {});
+  auto metadataWriter = ROOT::Experimental::RNTupleWriter::Append(std::move(metadata), root_utils::metaTreeName, *m_file,
+                                                                  getWriteOptions(root_utils::metaTreeName));
 
   metadataWriter->Fill();
 
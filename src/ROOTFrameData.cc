@@ -2,8 +2,12 @@
 
 namespace podio {
 
-ROOTFrameData::ROOTFrameData(BufferMap&& buffers, CollIDPtr&& idTable, podio::GenericParameters&& params) :
-    m_buffers(std::move(buffers)), m_idTable(std::move(idTable)), m_parameters(std::move(params)) {
+ROOTFrameData::ROOTFrameData(BufferMap&& buffers, CollIDPtr idTable, podio::GenericParameters&& params,
+                             podio::CollectionSizeIndex&& collSizes) :
+    m_buffers(std::move(buffers)),
+    m_idTable(std::move(idTable)),
+    m_parameters(std::move(params)),
+    m_collSizes(std::move(collSizes)) {
 }
 
 // Interim workaround for https://github.com/AIDASoft/podio/issues/500
@@ -24,7 +28,7 @@ std::optional<podio::CollectionReadBuffers> ROOTFrameData::getCollectionBuffers(
 
 podio::CollectionIDTable ROOTFrameData::getIDTable() const {
   // Construct a copy of the internal table
-  return {m_idTable->ids(), m_idTable->names()};
+  return m_idTable->copy();
 }
 
 std::unique_ptr<podio::GenericParameters> ROOTFrameData::getParameters() {
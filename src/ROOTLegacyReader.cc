@@ -84,11 +84,9 @@ ROOTLegacyReader::getCollectionBuffers(const std::pair<std::string, detail::Coll
   }
 
   // set the addresses and read the data
-  root_utils::setCollectionAddresses(collBuffers, branches);
+  root_utils::setReadBufferAddresses(collBuffers, branches);
   root_utils::readBranchesData(branches, localEntry);
 
-  collBuffers.recast(collBuffers);
-
   return collBuffers;
 }
 
@@ -120,11 +118,13 @@ void ROOTLegacyReader::openFiles(const std::vector<std::string>& filenames) {
   // NOTE: This is a small pessimization, if we do not read all collections
   // afterwards, but it makes the handling much easier in general
   auto metadatatree = static_cast<TTree*>(m_chain->GetFile()->Get("metadata"));
-  m_table = std::make_shared<CollectionIDTable>();
-  auto* table = m_table.get();
+  auto readTable = CollectionIDTable();
+  auto* table = &readTable;
   auto* tableBranch = root_utils::getBranch(metadatatree, "CollectionIDs");
   tableBranch->SetAddress(&table);
   tableBranch->GetEntry(0);
+  // ROOT only fills the persistent members, so create the indexed table here
+  m_table = CollectionIDTable::makeImmutable(std::vector(readTable.ids()), std::vector(readTable.names()));
 
   podio::version::Version* versionPtr{nullptr};
   if (auto* versionBranch = root_utils::getBranch(metadatatree, "PodioVersion")) {
@@ -11,13 +11,105 @@
 // ROOT specific includes
 #include "TChain.h"
 #include "TClass.h"
+#include "TROOT.h"
 
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
 #include <stdexcept>
+#include <thread>
 #include <unordered_map>
 
 namespace podio {
 
+/// The machinery for reading entries ahead on background threads. Each
+/// category that is read via readNextEntry gets its own Pipeline with a
+/// bounded queue of entries that are ready for consumption
+struct ROOTReader::Prefetcher {
+  /// An entry that has been read ahead, or the exception that occurred while
+  /// reading it. A nullptr without exception signals the end of the category
+  struct Entry {
+    std::unique_ptr<ROOTFrameData> data{nullptr};
+    std::exception_ptr error{nullptr};
+  };
+
+  struct Pipeline {
+    Pipeline(CategoryInfo* info, std::vector<std::string> colls) : catInfo(info), collsToRead(std::move(colls)) {
+    }
+    CategoryInfo* catInfo{nullptr};       ///< The category that is read by this pipeline
+    std::vector<std::string> collsToRead; ///< The collections that are read
+    std::deque<Entry> queue{};            ///< The entries that are ready
+    std::mutex mtx{};                     ///< Guards the queue and the stop flag
+    std::condition_variable cv{};         ///< Signals changes of the queue and the stop flag
+    bool stop{false};                     ///< Whether the background thread should stop
+    std::thread thread{};                 ///< The background thread reading the entries
+  };
+
+  /// Stop the background thread of the pipeline for a category (if there is
+  /// one) and discard all entries that have been read ahead
+  void stop(const std::string& category) {
+    if (auto it = pipelines.find(category); it != pipelines.end()) {
+      stop(*it->second);
+      pipelines.erase(it);
+    }
+  }
+
+  void stop(Pipeline& pipeline) {
+    {
+      std::lock_guard lock{pipeline.mtx};
+      pipeline.stop = true;
+    }
+    pipeline.cv.notify_all();
+    if (pipeline.thread.joinable()) {
+      pipeline.thread.join();
+    }
+
+    const auto nDiscarded =
+        std::ranges::count_if(pipeline.queue, [](const auto& entry) { return entry.data != nullptr; });
+    std::lock_guard statsLock{statsMtx};
+    stats.nDiscarded += nDiscarded;
+  }
+
+  void stopAll() {
+    for (auto& [_, pipeline] : pipelines) {
+      stop(*pipeline);
+    }
+    pipelines.clear();
+  }
+
+  /// Take the next entry from the queue of the pipeline, waiting for it if
+  /// necessary
+  Entry pop(Pipeline& pipeline) {
+    std::unique_lock lock{pipeline.mtx};
+    if (pipeline.queue.empty()) {
+      std::lock_guard statsLock{statsMtx};
+      stats.nWaits++;
+    }
+    pipeline.cv.wait(lock, [&pipeline]() { return !pipeline.queue.empty(); });
+    auto entry = std::move(pipeline.queue.front());
+    pipeline.queue.pop_front();
+    lock.unlock();
+    pipeline.cv.notify_all();
+    return entry;
+  }
+
+  size_t depth{0};                      ///< The maximum number of entries to read ahead per category
+  std::mutex readMtx{};                 ///< Serializes all reading via ROOT between the consumer and background threads
+  std::mutex statsMtx{};                ///< Guards the statistics
+  ROOTReaderPrefetchStatistics stats{}; ///< The statistics that are accumulated over all pipelines
+  std::unordered_map<std::string, std::unique_ptr<Pipeline>> pipelines{}; ///< The active pipelines per category
+};
+
+ROOTReader::ROOTReader() = default;
+
+ROOTReader::~ROOTReader() {
+  if (m_prefetcher) {
+    m_prefetcher->stopAll();
+  }
+}
+
 std::tuple<std::vector<root_utils::CollectionBranches>, std::vector<detail::NamedCollInfo>>
 createCollectionBranches(TChain* chain, const podio::CollectionIDTable& idTable,
                          const std::vector<root_utils::CollectionWriteInfoT>& collInfo);
@@ -42,13 +134,16 @@ void ROOTReader::readParams(ROOTReader::CategoryInfo& catInfo, podio::GenericPar
   auto keyBranch = catInfo.branches[collBranchIdx + brOffset.keys].data;
   auto valueBranch = catInfo.branches[collBranchIdx + brOffset.values].data;
 
-  root_utils::ParamStorage<T> storage;
-  keyBranch->SetAddress(storage.keysPtr());
+  // Read directly into the storage that is then taken over by the parameters
+  GenericParameters::Storage<T> storage;
+  auto* keys = &storage.keys;
+  keyBranch->SetAddress(&keys);
   keyBranch->GetEntry(localEntry);
-  valueBranch->SetAddress(storage.valuesPtr());
+  auto* values = &storage.values;
+  valueBranch->SetAddress(&values);
   valueBranch->GetEntry(localEntry);
 
-  params.loadFrom(std::move(storage.keys), std::move(storage.values));
+  params.loadFrom(std::move(storage));
 }
 
 GenericParameters ROOTReader::readEntryParameters(ROOTReader::CategoryInfo& catInfo, bool reloadBranches,
@@ -81,12 +176,21 @@ GenericParameters ROOTReader::readEntryParameters(ROOTReader::CategoryInfo& catI
 
 std::unique_ptr<ROOTFrameData> ROOTReader::readNextEntry(const std::string& name,
                                                          const std::vector<std::string>& collsToRead) {
+  if (m_prefetcher) {
+    return readNextPrefetchedEntry(name, collsToRead);
+  }
   auto& catInfo = getCategoryInfo(name);
   return readEntry(catInfo, collsToRead);
 }
 
 std::unique_ptr<ROOTFrameData> ROOTReader::readEntry(const std::string& name, const unsigned entNum,
                                                      const std::vector<std::string>& collsToRead) {
+  auto lock = std::unique_lock<std::mutex>{};
+  if (m_prefetcher) {
+    // The entries that have been read ahead are no longer what is needed
+    m_prefetcher->stop(name);
+    lock = std::unique_lock{m_prefetcher->readMtx};
+  }
   auto& catInfo = getCategoryInfo(name);
   catInfo.entry = entNum;
   return readEntry(catInfo, collsToRead);
@@ -94,31 +198,44 @@ std::unique_ptr<ROOTFrameData> ROOTReader::readEntry(const std::string& name, co
 
 std::unique_ptr<ROOTFrameData> ROOTReader::readEntry(ROOTReader::CategoryInfo& catInfo,
                                                      const std::vector<std::string>& collsToRead) {
+  auto data = readEntryData(catInfo, catInfo.entry, collsToRead);
+  if (data) {
+    catInfo.entry++;
+  }
+  return data;
+}
+
+void checkCollsToRead(const std::vector<detail::NamedCollInfo>& storedClasses,
+                      const std::vector<std::string>& collsToRead) {
+  // Make sure to not silently ignore non-existant but requested collections
+  for (const auto& name : collsToRead) {
+    if (std::ranges::find(storedClasses, name, &detail::NamedCollInfo::name) == storedClasses.end()) {
+      throw std::invalid_argument(name + " is not available from Frame");
+    }
+  }
+}
+
+std::unique_ptr<ROOTFrameData> ROOTReader::readEntryData(ROOTReader::CategoryInfo& catInfo, unsigned entry,
+                                                         const std::vector<std::string>& collsToRead) {
   if (!catInfo.chain) {
     return nullptr;
   }
-  if (catInfo.entry >= catInfo.chain->GetEntries()) {
+  if (entry >= catInfo.chain->GetEntries()) {
     return nullptr;
   }
 
-  // Make sure to not silently ignore non-existant but requested collections
-  if (!collsToRead.empty()) {
-    for (const auto& name : collsToRead) {
-      if (std::ranges::find(catInfo.storedClasses, name, &detail::NamedCollInfo::name) == catInfo.storedClasses.end()) {
-        throw std::invalid_argument(name + " is not available from Frame");
-      }
-    }
-  }
+  checkCollsToRead(catInfo.storedClasses, collsToRead);
 
   // After switching trees in the chain, branch pointers get invalidated so
   // they need to be reassigned.
   // NOTE: root 6.22/06 requires that we get completely new branches here,
   // with 6.20/04 we could just re-set them
   const auto preTreeNo = catInfo.chain->GetTreeNumber();
-  const auto localEntry = catInfo.chain->LoadTree(catInfo.entry);
+  const auto localEntry = catInfo.chain->LoadTree(entry);
   const auto treeChange = catInfo.chain->GetTreeNumber() != preTreeNo;
   // Also need to make sure to handle the first event
-  const auto reloadBranches = treeChange || localEntry == 0;
+  const auto reloadBranches = treeChange || localEntry == 0 || catInfo.branchesStale;
+  catInfo.branchesStale = false;
 
   ROOTFrameData::BufferMap buffers;
   for (size_t i = 0; i < catInfo.storedClasses.size(); ++i) {
@@ -129,9 +246,280 @@ std::unique_ptr<ROOTFrameData> ROOTReader::readEntry(ROOTReader::CategoryInfo& c
   }
 
   auto parameters = readEntryParameters(catInfo, reloadBranches, localEntry);
+  auto collSizes = readCollectionSizes(catInfo, reloadBranches, localEntry, collsToRead);
 
-  catInfo.entry++;
-  return std::make_unique<ROOTFrameData>(std::move(buffers), catInfo.table, std::move(parameters));
+  return std::make_unique<ROOTFrameData>(std::move(buffers), catInfo.table, std::move(parameters),
+                                         std::move(collSizes));
+}
+
+std::vector<std::unique_ptr<ROOTFrameData>> ROOTReader::readEntries(const std::string& name, const unsigned first,
+                                                                    const unsigned count,
+                                                                    const std::vector<std::string>& collsToRead) {
+  auto lock = std::unique_lock<std::mutex>{};
+  if (m_prefetcher) {
+    m_prefetcher->stop(name);
+    lock = std::unique_lock{m_prefetcher->readMtx};
+  }
+
+  std::vector<std::unique_ptr<ROOTFrameData>> entries{};
+  auto& catInfo = getCategoryInfo(name);
+  if (!catInfo.chain || first >= catInfo.chain->GetEntries()) {
+    return entries;
+  }
+  checkCollsToRead(catInfo.storedClasses, collsToRead);
+
+  std::vector<size_t> collIndices{};
+  for (size_t i = 0; i < catInfo.storedClasses.size(); ++i) {
+    if (collsToRead.empty() || std::ranges::find(collsToRead, catInfo.storedClasses[i].name) != collsToRead.end()) {
+      collIndices.push_back(i);
+    }
+  }
+
+  const auto last = std::min<Long64_t>(Long64_t{first} + count, catInfo.chain->GetEntries());
+  const auto nEntries = static_cast<size_t>(last - first);
+  std::vector<ROOTFrameData::BufferMap> buffers(nEntries);
+  std::vector<GenericParameters> parameters{};
+  parameters.reserve(nEntries);
+  std::vector<CollectionSizeIndex> collSizes{};
+  collSizes.reserve(nEntries);
+
+  // Let the TTreeCache fetch the baskets of all branches that are read for the
+  // whole range up front, such that ROOT can do a few large reads instead of
+  // one read per basket. The cache only prefetches for the entry that has been
+  // loaded last, so every entry has to be loaded before reading its branches
+  setupCacheForRange(catInfo, collIndices, first, last);
+
+  // Read the entries in chunks that lie in the same tree of the chain, since
+  // the branches have to be reloaded when switching trees
+  try {
+    Long64_t chunkStart = first;
+    while (chunkStart < last) {
+      const auto preTreeNo = catInfo.chain->GetTreeNumber();
+      const auto localStart = catInfo.chain->LoadTree(chunkStart);
+      const auto treeChange = catInfo.chain->GetTreeNumber() != preTreeNo;
+      const auto reloadBranches = treeChange || localStart == 0 || catInfo.branchesStale;
+      catInfo.branchesStale = false;
+      const auto chunkEnd = std::min(last, chunkStart + catInfo.chain->GetTree()->GetEntries() - localStart);
+
+      for (auto entry = chunkStart; entry < chunkEnd; ++entry) {
+        const auto localEntry = static_cast<unsigned>(catInfo.chain->LoadTree(entry));
+        const auto reload = reloadBranches && entry == chunkStart;
+        for (const auto iColl : collIndices) {
+          buffers[entry - first].emplace(catInfo.storedClasses[iColl].name,
+                                         getCollectionBuffers(catInfo, iColl, reload, localEntry));
+        }
+        parameters.emplace_back(readEntryParameters(catInfo, reload, localEntry));
+        collSizes.emplace_back(readCollectionSizes(catInfo, reload, localEntry, collsToRead));
+      }
+
+      chunkStart = chunkEnd;
+    }
+  } catch (...) {
+    restoreCache(catInfo);
+    throw;
+  }
+  restoreCache(catInfo);
+
+  entries.reserve(nEntries);
+  for (size_t i = 0; i < nEntries; ++i) {
+    entries.emplace_back(
+        std::make_unique<ROOTFrameData>(std::move(buffers[i]), catInfo.table, std::move(parameters[i]),
+                                        std::move(collSizes[i])));
+  }
+  catInfo.entry = static_cast<unsigned>(last);
+
+  return entries;
+}
+
+void ROOTReader::setupCacheForRange(ROOTReader::CategoryInfo& catInfo, const std::vector<size_t>& collIndices,
+                                    Long64_t first, Long64_t last) {
+  auto* chain = catInfo.chain.get();
+  if (chain->GetCacheSize() <= 0) {
+    // Use the default size that ROOT determines from the clusters
+    chain->SetCacheSize(-1);
+  }
+  chain->SetCacheEntryRange(first, last);
+
+  const auto addBranch = [chain](const std::string& name) {
+    if (chain->GetBranch(name.c_str())) {
+      chain->AddBranchToCache(name.c_str(), true);
+    }
+  };
+  for (const auto iColl : collIndices) {
+    const auto& name = catInfo.storedClasses[iColl].name;
+    const auto& branches = catInfo.branches[std::get<3>(catInfo.storedClasses[iColl].info)];
+    if (branches.data) {
+      addBranch(name);
+    }
+    for (const auto& brName : branches.refNames) {
+      addBranch(brName);
+    }
+    for (const auto& brName : branches.vecNames) {
+      addBranch(brName);
+    }
+  }
+  for (const auto* brName :
+       {root_utils::paramBranchName, root_utils::intKeyName, root_utils::intValueName, root_utils::floatKeyName,
+        root_utils::floatValueName, root_utils::doubleKeyName, root_utils::doubleValueName, root_utils::stringKeyName,
+        root_utils::stringValueName, root_utils::collElementsName, root_utils::collBytesName}) {
+    addBranch(brName);
+  }
+  // All the branches that will be read are known, so there is no need for the
+  // cache to learn them
+  chain->StopCacheLearningPhase();
+}
+
+void ROOTReader::restoreCache(ROOTReader::CategoryInfo& catInfo) {
+  // Replace the cache with a new one of the same size, since the learning
+  // phase of a cache cannot be restarted and its branches cannot be reset
+  // otherwise. The new cache covers all entries and learns the branches that
+  // later reads actually use again
+  auto* chain = catInfo.chain.get();
+  const auto cacheSize = chain->GetCacheSize();
+  chain->SetCacheSize(0);
+  chain->SetCacheSize(cacheSize);
+}
+
+std::unique_ptr<ROOTFrameData> ROOTReader::readNextPrefetchedEntry(const std::string& name,
+                                                                   const std::vector<std::string>& collsToRead) {
+  auto& prefetcher = *m_prefetcher;
+  auto it = prefetcher.pipelines.find(name);
+  if (it != prefetcher.pipelines.end() && it->second->collsToRead != collsToRead) {
+    prefetcher.stop(name);
+    it = prefetcher.pipelines.end();
+  }
+
+  if (it == prefetcher.pipelines.end()) {
+    CategoryInfo* catInfo = nullptr;
+    {
+      std::lock_guard lock{prefetcher.readMtx};
+      catInfo = &getCategoryInfo(name);
+      if (!catInfo->chain || catInfo->entry >= catInfo->chain->GetEntries()) {
+        return nullptr;
+      }
+    }
+    // Report unavailable collections here rather than on the background thread
+    checkCollsToRead(catInfo->storedClasses, collsToRead);
+
+    it = prefetcher.pipelines.emplace(name, std::make_unique<Prefetcher::Pipeline>(catInfo, collsToRead)).first;
+    auto& pipeline = *it->second;
+    pipeline.thread = std::thread([this, &prefetcher, &pipeline, startEntry = catInfo->entry]() {
+      for (auto entry = startEntry;; ++entry) {
+        {
+          std::unique_lock lock{pipeline.mtx};
+          pipeline.cv.wait(lock, [&]() { return pipeline.stop || pipeline.queue.size() < prefetcher.depth; });
+          if (pipeline.stop) {
+            return;
+          }
+        }
+
+        Prefetcher::Entry next{};
+        {
+          std::lock_guard readLock{prefetcher.readMtx};
+          try {
+            next.data = readEntryData(*pipeline.catInfo, entry, pipeline.collsToRead);
+          } catch (...) {
+            next.error = std::current_exception();
+          }
+        }
+
+        const bool finished = !next.data;
+        size_t queueDepth = 0;
+        {
+          std::lock_guard lock{pipeline.mtx};
+          pipeline.queue.emplace_back(std::move(next));
+          queueDepth = pipeline.queue.size();
+        }
+        pipeline.cv.notify_all();
+        if (finished) {
+          return;
+        }
+
+        std::lock_guard statsLock{prefetcher.statsMtx};
+        prefetcher.stats.nPrefetched++;
+        prefetcher.stats.maxQueueDepth = std::max(prefetcher.stats.maxQueueDepth, queueDepth);
+      }
+    });
+  }
+
+  auto& pipeline = *it->second;
+  auto next = prefetcher.pop(pipeline);
+  if (!next.data) {
+    // Either the end of the category has been reached or reading failed. In
+    // both cases the pipeline has finished and the next call starts over
+    prefetcher.stop(name);
+    if (next.error) {
+      std::rethrow_exception(next.error);
+    }
+    return nullptr;
+  }
+
+  pipeline.catInfo->entry++;
+  return std::move(next.data);
+}
+
+std::optional<podio::CollectionSizeIndex> ROOTReader::getCollectionSizes(const std::string& name,
+                                                                          const unsigned entry) {
+  auto lock = std::unique_lock<std::mutex>{};
+  if (m_prefetcher) {
+    lock = std::unique_lock{m_prefetcher->readMtx};
+  }
+  auto& catInfo = getCategoryInfo(name);
+  if (!catInfo.chain || entry >= catInfo.chain->GetEntries()) {
+    return std::nullopt;
+  }
+
+  const auto preTreeNo = catInfo.chain->GetTreeNumber();
+  const auto localEntry = catInfo.chain->LoadTree(entry);
+  const auto treeChange = catInfo.chain->GetTreeNumber() != preTreeNo;
+  // The branches of the collection data also have to be reloaded before
+  // reading the next entry if we switched trees here
+  catInfo.branchesStale = catInfo.branchesStale || treeChange;
+
+  auto collSizes = readCollectionSizes(catInfo, treeChange || localEntry == 0, localEntry, {});
+  if (collSizes.empty() && !catInfo.storedClasses.empty()) {
+    return std::nullopt;
+  }
+  return collSizes;
+}
+
+podio::CollectionSizeIndex ROOTReader::readCollectionSizes(ROOTReader::CategoryInfo& catInfo, bool reloadBranches,
+                                                           unsigned int localEntry,
+                                                           const std::vector<std::string>& collsToRead) {
+  if (reloadBranches) {
+    // These are not present in files that have been written by older versions
+    // of podio, in which case we simply get a nullptr
+    catInfo.collElementsBranch = root_utils::getBranch(catInfo.chain.get(), root_utils::collElementsName);
+    catInfo.collBytesBranch = root_utils::getBranch(catInfo.chain.get(), root_utils::collBytesName);
+  }
+  if (!catInfo.collElementsBranch || !catInfo.collBytesBranch) {
+    return {};
+  }
+
+  std::vector<uint64_t> elements{};
+  auto* elementsPtr = &elements;
+  catInfo.collElementsBranch->SetAddress(&elementsPtr);
+  catInfo.collElementsBranch->GetEntry(localEntry);
+  std::vector<uint64_t> bytes{};
+  auto* bytesPtr = &bytes;
+  catInfo.collBytesBranch->SetAddress(&bytesPtr);
+  catInfo.collBytesBranch->GetEntry(localEntry);
+
+  // The sizes are stored in the same order as the collection infos
+  podio::CollectionSizeIndex collSizes{};
+  const auto nColls = catInfo.storedClasses.size();
+  if (elements.size() != nColls || bytes.size() != nColls || catInfo.valueTypes.size() != nColls) {
+    return collSizes;
+  }
+  for (size_t i = 0; i < catInfo.storedClasses.size(); ++i) {
+    const auto& name = catInfo.storedClasses[i].name;
+    if (!collsToRead.empty() && std::ranges::find(collsToRead, name) == collsToRead.end()) {
+      continue;
+    }
+    collSizes.emplace(name, CollectionSizeInfo{catInfo.valueTypes[i], elements[i], bytes[i]});
+  }
+
+  return collSizes;
 }
 
 podio::CollectionReadBuffers ROOTReader::getCollectionBuffers(ROOTReader::CategoryInfo& catInfo, size_t iColl,
@@ -151,11 +539,9 @@ podio::CollectionReadBuffers ROOTReader::getCollectionBuffers(ROOTReader::Catego
   }
 
   // set the addresses and read the data
-  root_utils::setCollectionAddresses(collBuffers, branches);
+  root_utils::setReadBufferAddresses(collBuffers, branches);
   root_utils::readBranchesData(branches, localEntry);
 
-  collBuffers.recast(collBuffers);
-
   return collBuffers;
 }
 
@@ -177,11 +563,13 @@ ROOTReader::CategoryInfo& ROOTReader::getCategoryInfo(const std::string& categor
 }
 
 void ROOTReader::initCategory(CategoryInfo& catInfo, const std::string& category) {
-  catInfo.table = std::make_shared<podio::CollectionIDTable>();
-  auto* table = catInfo.table.get();
+  auto readTable = podio::CollectionIDTable();
+  auto* table = &readTable;
   auto* tableBranch = root_utils::getBranch(m_metaChain.get(), root_utils::idTableName(category));
   tableBranch->SetAddress(&table);
   tableBranch->GetEntry(0);
+  // ROOT only fills the persistent members, so create the indexed table here
+  catInfo.table = podio::CollectionIDTable::makeImmutable(std::vector(readTable.ids()), std::vector(readTable.names()));
 
   auto* collInfoBranch = root_utils::getBranch(m_metaChain.get(), root_utils::collInfoName(category));
 
@@ -201,6 +589,13 @@ void ROOTReader::initCategory(CategoryInfo& catInfo, const std::string& category
     collInfoBranch->GetEntry(0);
   }
 
+  // Only present in files with a collection size index
+  if (auto* valueTypesBranch = root_utils::getBranch(m_metaChain.get(), root_utils::valueTypesName(category))) {
+    auto* valueTypes = &catInfo.valueTypes;
+    valueTypesBranch->SetAddress(&valueTypes);
+    valueTypesBranch->GetEntry(0);
+  }
+
   // For backwards compatibility make it possible to read the index based files
   // from older versions
   if (m_fileVersion < podio::version::Version{0, 16, 99}) {
@@ -254,6 +649,9 @@ void ROOTReader::openFile(const std::string& filename) {
 }
 
 void ROOTReader::openFiles(const std::vector<std::string>& filenames) {
+  if (m_prefetcher) {
+    m_prefetcher->stopAll();
+  }
   m_metaChain = std::make_unique<TChain>(root_utils::metaTreeName);
   // NOTE: We simply assume that the meta data doesn't change throughout the
   // chain! This essentially boils down to the assumption that all files that
@@ -306,7 +704,45 @@ void ROOTReader::openFiles(const std::vector<std::string>& filenames) {
   }
 }
 
+void ROOTReader::enablePrefetch(size_t depth) {
+  if (m_prefetcher) {
+    m_prefetcher->stopAll();
+  }
+  if (depth == 0) {
+    m_prefetcher.reset();
+    return;
+  }
+
+  // Entries are read on other threads than the one using the reader
+  ROOT::EnableThreadSafety();
+  if (!m_prefetcher) {
+    m_prefetcher = std::make_unique<Prefetcher>();
+  }
+  m_prefetcher->depth = depth;
+}
+
+ROOTReaderPrefetchStatistics ROOTReader::getPrefetchStatistics() const {
+  if (!m_prefetcher) {
+    return {};
+  }
+
+  size_t queueDepth = 0;
+  for (const auto& [_, pipeline] : m_prefetcher->pipelines) {
+    std::lock_guard lock{pipeline->mtx};
+    queueDepth += std::ranges::count_if(pipeline->queue, [](const auto& entry) { return entry.data != nullptr; });
+  }
+
+  std::lock_guard statsLock{m_prefetcher->statsMtx};
+  auto stats = m_prefetcher->stats;
+  stats.queueDepth = queueDepth;
+  return stats;
+}
+
 unsigned ROOTReader::getEntries(const std::string& name) const {
+  auto lock = std::unique_lock<std::mutex>{};
+  if (m_prefetcher) {
+    lock = std::unique_lock{m_prefetcher->readMtx};
+  }
   if (auto it = m_categories.find(name); it != m_categories.end()) {
     return it->second.chain->GetEntries();
   }
@@ -12,8 +12,11 @@
 
 namespace podio {
 
-ROOTWriter::ROOTWriter(const std::string& filename) {
+ROOTWriter::ROOTWriter(const std::string& filename, const WriterOptions& options) : m_options(options) {
   m_file = std::make_unique<TFile>(filename.c_str(), "recreate");
+  if (const auto settings = root_utils::getCompressionSettings(m_options.compression)) {
+    m_file->SetCompressionSettings(settings.value());
+  }
 }
 
 ROOTWriter::~ROOTWriter() {
@@ -50,10 +53,24 @@ void ROOTWriter::writeFrame(const podio::Frame& frame, const std::string& catego
     collections.emplace_back(name, const_cast<podio::CollectionBase*>(coll));
   }
 
+  // The parameters are written without copying them, so they must not change
+  // until the entry has been filled
+  const auto params = frame.getParameters().lockedView();
+
   // We will at least have a parameters branch, even if there are no
   // collections
   if (catInfo.branches.empty()) {
-    initBranches(catInfo, collections, const_cast<podio::GenericParameters&>(frame.getParameters()));
+    initBranches(catInfo, collections, params);
+
+    // All branches inherit the compression settings of the file, unless there
+    // are dedicated ones for this category
+    if (m_options.hasCategoryCompression(category)) {
+      const auto settings = root_utils::getCompressionSettings(m_options.getCompression(category))
+                                .value_or(ROOT::RCompressionSetting::EDefaults::kUseCompiledDefault);
+      for (const auto& branches : catInfo.branches) {
+        root_utils::setCompressionSettings(branches, settings);
+      }
+    }
 
   } else {
     // Make sure that the category contents are consistent with the initial
@@ -62,10 +79,11 @@ void ROOTWriter::writeFrame(const podio::Frame& frame, const std::string& catego
       throw std::runtime_error("Trying to write category '" + category + "' with inconsistent collection content. " +
                                root_utils::getInconsistentCollsMsg(catInfo.collsToWrite, collsToWrite));
     }
-    fillParams(catInfo, frame.getParameters());
+    fillParams(catInfo, params);
     resetBranches(catInfo, collections);
   }
 
+  fillCollectionSizes(catInfo, collections);
   catInfo.tree->Fill();
 }
 
@@ -79,8 +97,9 @@ ROOTWriter::CategoryInfo& ROOTWriter::getCategoryInfo(const std::string& categor
 }
 
 void ROOTWriter::initBranches(CategoryInfo& catInfo, const std::vector<root_utils::StoreCollection>& collections,
-                              /*const*/ podio::GenericParameters& parameters) {
-  catInfo.branches.reserve(collections.size() + root_utils::nParamBranches); // collections + parameters
+                              const podio::GenericParameters::LockedView& parameters) {
+  // collections + parameters + collection sizes
+  catInfo.branches.reserve(collections.size() + root_utils::nParamBranches + 2);
 
   // First collections
   for (auto& [name, coll] : collections) {
@@ -122,22 +141,28 @@ void ROOTWriter::initBranches(CategoryInfo& catInfo, const std::vector<root_util
     catInfo.branches.emplace_back(std::move(branches));
     catInfo.collInfo.emplace_back(catInfo.idTable.collectionID(name).value(), std::string(coll->getTypeName()),
                                   coll->isSubsetCollection(), coll->getSchemaVersion());
+    catInfo.valueTypes.emplace_back(coll->getValueTypeName());
   }
 
   fillParams(catInfo, parameters);
   // NOTE: The order in which these are created is codified for later use in
   // root_utils::getGPBranchOffsets
-  catInfo.branches.emplace_back(catInfo.tree->Branch(root_utils::intKeyName, &catInfo.intParams.keys));
-  catInfo.branches.emplace_back(catInfo.tree->Branch(root_utils::intValueName, &catInfo.intParams.values));
+  catInfo.branches.emplace_back(catInfo.tree->Branch(root_utils::intKeyName, catInfo.intParams.keysPtr()));
+  catInfo.branches.emplace_back(catInfo.tree->Branch(root_utils::intValueName, catInfo.intParams.valuesPtr()));
 
-  catInfo.branches.emplace_back(catInfo.tree->Branch(root_utils::floatKeyName, &catInfo.floatParams.keys));
-  catInfo.branches.emplace_back(catInfo.tree->Branch(root_utils::floatValueName, &catInfo.floatParams.values));
+  catInfo.branches.emplace_back(catInfo.tree->Branch(root_utils::floatKeyName, catInfo.floatParams.keysPtr()));
+  catInfo.branches.emplace_back(catInfo.tree->Branch(root_utils::floatValueName, catInfo.floatParams.valuesPtr()));
 
-  catInfo.branches.emplace_back(catInfo.tree->Branch(root_utils::doubleKeyName, &catInfo.doubleParams.keys));
-  catInfo.branches.emplace_back(catInfo.tree->Branch(root_utils::doubleValueName, &catInfo.doubleParams.values));
+  catInfo.branches.emplace_back(catInfo.tree->Branch(root_utils::doubleKeyName, catInfo.doubleParams.keysPtr()));
+  catInfo.branches.emplace_back(catInfo.tree->Branch(root_utils::doubleValueName, catInfo.doubleParams.valuesPtr()));
 
-  catInfo.branches.emplace_back(catInfo.tree->Branch(root_utils::stringKeyName, &catInfo.stringParams.keys));
-  catInfo.branches.emplace_back(catInfo.tree->Branch(root_utils::stringValueName, &catInfo.stringParams.values));
+  catInfo.branches.emplace_back(catInfo.tree->Branch(root_utils::stringKeyName, catInfo.stringParams.keysPtr()));
+  catInfo.branches.emplace_back(catInfo.tree->Branch(root_utils::stringValueName, catInfo.stringParams.valuesPtr()));
+
+  // The collection size index comes after the parameters in order to not change
+  // the offsets of the parameter branches
+  catInfo.branches.emplace_back(catInfo.tree->Branch(root_utils::collElementsName, &catInfo.collElements));
+  catInfo.branches.emplace_back(catInfo.tree->Branch(root_utils::collBytesName, &catInfo.collBytes));
 }
 
 void ROOTWriter::resetBranches(CategoryInfo& categoryInfo,
@@ -177,6 +202,7 @@ void ROOTWriter::finish() {
   for (/*const*/ auto& [category, info] : m_categories) {
     metaTree->Branch(root_utils::idTableName(category).c_str(), &info.idTable);
     metaTree->Branch(root_utils::collInfoName(category).c_str(), &info.collInfo);
+    metaTree->Branch(root_utils::valueTypesName(category).c_str(), &info.valueTypes);
   }
 
   // Store the current podio build version into the meta data tree
@@ -215,11 +241,21 @@ ROOTWriter::checkConsistency(const std::vector<std::string>& collsToWrite, const
   return {std::vector<std::string>{}, collsToWrite};
 }
 
-void ROOTWriter::fillParams(CategoryInfo& catInfo, const GenericParameters& params) {
-  catInfo.intParams = params.getKeysAndValues<int>();
-  catInfo.floatParams = params.getKeysAndValues<float>();
-  catInfo.doubleParams = params.getKeysAndValues<double>();
-  catInfo.stringParams = params.getKeysAndValues<std::string>();
+void ROOTWriter::fillCollectionSizes(CategoryInfo& catInfo,
+                                     const std::vector<root_utils::StoreCollection>& collections) {
+  catInfo.collElements.clear();
+  catInfo.collBytes.clear();
+  for (const auto& [_, coll] : collections) {
+    catInfo.collElements.push_back(coll->size());
+    catInfo.collBytes.push_back(coll->getBuffers().nBytes);
+  }
+}
+
+void ROOTWriter::fillParams(CategoryInfo& catInfo, const GenericParameters::LockedView& params) {
+  catInfo.intParams.bind(params.getStorage<int>());
+  catInfo.floatParams.bind(params.getStorage<float>());
+  catInfo.doubleParams.bind(params.getStorage<double>());
+  catInfo.stringParams.bind(params.getStorage<std::string>());
 }
 
 } // namespace podio
@@ -1,5 +1,7 @@
 #include "podio/SIOBlock.h"
 
+#include "sioUtils.h"
+
 #include <algorithm>
 #include <cstdlib>
 #include <dlfcn.h>
@@ -26,19 +28,84 @@ void SIOCollectionIDTableBlock::write(sio::write_device& device) {
   device.data(_isSubsetColl);
 }
 
+void SIOCompressedBlockIndexBlock::read(sio::read_device& device, sio::version_type version) {
+  device.data(offsets);
+  device.data(compressedSizes);
+  device.data(uncompressedSizes);
+  if (version >= sio::version::encode_version(0, 2)) {
+    device.data(compressed);
+  }
+}
+
+void SIOCompressedBlockIndexBlock::write(sio::write_device& device) {
+  device.data(offsets);
+  device.data(compressedSizes);
+  device.data(uncompressedSizes);
+  device.data(compressed);
+}
+
+void SIOCollectionSizeIndexBlock::read(sio::read_device& device, sio::version_type) {
+  device.data(elements);
+  device.data(bytes);
+}
+
+void SIOCollectionSizeIndexBlock::write(sio::write_device& device) {
+  device.data(elements);
+  device.data(bytes);
+}
+
+void SIOCompressedBlocksBlock::read(sio::read_device& device, sio::version_type) {
+  unsigned size{0};
+  device.data(size);
+  data.resize(size);
+  podio::handlePODDataSIO(device, data.data(), size);
+}
+
+void SIOCompressedBlocksBlock::write(sio::write_device& device) {
+  unsigned size = data.size();
+  device.data(size);
+  podio::handlePODDataSIO(device, data.data(), size);
+}
+
+namespace {
+  /// Write the parameters of one type in the same way as an std::map
+  template <typename T>
+  void writeParameters(sio::write_device& device, const GenericParameters::Storage<T>& storage) {
+    device.data((int)storage.size());
+    for (size_t i = 0; i < storage.size(); ++i) {
+      device.data(storage.keys[i]);
+      device.data(storage.values[i]);
+    }
+  }
+
+  /// Read the parameters of one type that have been written like an std::map
+  template <typename T>
+  void readParameters(sio::read_device& device, GenericParameters::Storage<T>& storage) {
+    int size;
+    device.data(size);
+    storage.keys.reserve(storage.size() + size);
+    storage.values.reserve(storage.size() + size);
+    while (size--) {
+      std::string key;
+      device.data(key);
+      device.data(storage.getOrInsert(key));
+    }
+  }
+} // namespace
+
 void writeGenericParameters(sio::write_device& device, const GenericParameters& params) {
-  writeMapLike(device, params.getMap<int>());
-  writeMapLike(device, params.getMap<float>());
-  writeMapLike(device, params.getMap<std::string>());
-  writeMapLike(device, params.getMap<double>());
+  writeParameters(device, params.getStorage<int>());
+  writeParameters(device, params.getStorage<float>());
+  writeParameters(device, params.getStorage<std::string>());
+  writeParameters(device, params.getStorage<double>());
 }
 
 void readGenericParameters(sio::read_device& device, GenericParameters& params, sio::version_type version) {
-  readMapLike(device, params.getMap<int>());
-  readMapLike(device, params.getMap<float>());
-  readMapLike(device, params.getMap<std::string>());
+  readParameters(device, params.getStorage<int>());
+  readParameters(device, params.getStorage<float>());
+  readParameters(device, params.getStorage<std::string>());
   if (version >= sio::version::encode_version(0, 2)) {
-    readMapLike(device, params.getMap<double>());
+    readParameters(device, params.getStorage<double>());
   }
 }
 
@@ -206,14 +273,20 @@ std::vector<std::string_view> SIOFileTOCRecord::getRecordNames() const {
   return cats;
 }
 
-void SIOFileTOCRecordBlock::read(sio::read_device& device, sio::version_type) {
+void SIOFileTOCRecordBlock::read(sio::read_device& device, sio::version_type version) {
   int size;
   device.data(size);
   while (size--) {
     std::string name;
     device.data(name);
     std::vector<SIOFileTOCRecord::PositionType> positions;
-    device.data(positions);
+    if (version < sio::version::encode_version(0, 2)) {
+      std::vector<uint32_t> smallPositions;
+      device.data(smallPositions);
+      positions.assign(smallPositions.begin(), smallPositions.end());
+    } else {
+      device.data(positions);
+    }
 
     record->m_recordMap.emplace_back(std::move(name), std::move(positions));
   }
@@ -223,8 +296,68 @@ void SIOFileTOCRecordBlock::write(sio::write_device& device) {
   device.data((int)record->m_recordMap.size());
   for (const auto& [name, positions] : record->m_recordMap) {
     device.data(name);
-    device.data(positions);
+    if (version() < sio::version::encode_version(0, 2)) {
+      const auto smallPositions = std::vector<uint32_t>(positions.begin(), positions.end());
+      device.data(smallPositions);
+    } else {
+      device.data(positions);
+    }
   }
 }
 
+namespace sio_helpers {
+  void writeFileTOCRecord(sio::ofstream& stream, SIOFileTOCRecord& tocRecord) {
+    // All records are in front of the TOC record, so if it fits into 32 bits,
+    // all other positions do as well
+    const auto tocStartPos = static_cast<uint64_t>(stream.tellp());
+    const bool largePositions = tocStartPos > 0xffffffff;
+
+    sio::block_list blocks;
+    blocks.emplace_back(std::make_shared<SIOFileTOCRecordBlock>(&tocRecord, largePositions));
+    sio_utils::writeRecord(blocks, SIOTocRecordName, stream);
+
+    // Now that we know the position of the TOC Record, put this information
+    // into a final marker that can be identified and interpreted when reading
+    // again
+    if (largePositions) {
+      const uint64_t finalWords[2] = {tocStartPos, ((uint64_t)SIOTocMarker64) << 32};
+      stream.write(reinterpret_cast<const char*>(finalWords), sizeof(finalWords));
+    } else {
+      const uint64_t finalWords = (((uint64_t)SIOTocMarker) << 32) | (tocStartPos & 0xffffffff);
+      stream.write(reinterpret_cast<const char*>(&finalWords), sizeof(finalWords));
+    }
+  }
+
+  bool readFileTOCRecord(sio::ifstream& stream, SIOFileTOCRecord& tocRecord) {
+    // Check if there is a dedicated marker at the end of the file that tells us
+    // where the TOC actually starts
+    stream.seekg(-SIOTocInfoSize, std::ios_base::end);
+    uint64_t lastWord{0};
+    stream.read(reinterpret_cast<char*>(&lastWord), sizeof(lastWord));
+
+    const uint32_t marker = (lastWord >> 32) & 0xffffffff;
+    uint64_t position{0};
+    if (marker == SIOTocMarker) {
+      position = lastWord & 0xffffffff;
+    } else if (marker == SIOTocMarker64) {
+      stream.seekg(-SIOTocInfoSize64, std::ios_base::end);
+      stream.read(reinterpret_cast<char*>(&position), sizeof(position));
+    } else {
+      stream.clear();
+      stream.seekg(0);
+      return false;
+    }
+
+    stream.seekg(position);
+    const auto& [uncBuffer, _] = sio_utils::readRecord(stream);
+
+    sio::block_list blocks;
+    blocks.emplace_back(std::make_shared<SIOFileTOCRecordBlock>(&tocRecord));
+    sio::api::read_blocks(uncBuffer.span(), blocks);
+
+    stream.seekg(0);
+    return true;
+  }
+} // namespace sio_helpers
+
 } // namespace podio
@@ -1,6 +1,9 @@
 #include "podio/SIOFrameData.h"
 #include "podio/SIOBlock.h"
 
+#include "sioUtils.h"
+
+#include <sio/api.h>
 #include <sio/compression/zlib.h>
 
 #include <algorithm>
@@ -12,17 +15,44 @@ SIOFrameData::SIOFrameData(sio::buffer&& collBuffers, std::size_t dataSize, sio:
                            std::size_t tableSize, std::vector<std::string> limitColls) :
     m_recBuffer(std::move(collBuffers)),
     m_tableBuffer(std::move(tableBuffer)),
+    m_recData(m_recBuffer.span()),
     m_dataSize(dataSize),
     m_tableSize(tableSize),
     m_limitColls(std::move(limitColls)) {
-  readIdTable();
+  readIdTable(m_tableBuffer.span());
+  checkLimitColls();
+}
+
+SIOFrameData::SIOFrameData(sio::buffer&& collBuffers, const sio::record_info& dataInfo, sio::buffer&& tableBuffer,
+                           const sio::record_info& tableInfo, std::vector<std::string> limitColls) :
+    m_recBuffer(std::move(collBuffers)),
+    m_tableBuffer(std::move(tableBuffer)),
+    m_recData(m_recBuffer.span(0, dataInfo._data_length)),
+    m_dataSize(dataInfo._uncompressed_length),
+    m_tableSize(tableInfo._uncompressed_length),
+    m_limitColls(std::move(limitColls)) {
+  readIdTable(m_tableBuffer.span(0, tableInfo._data_length));
+  checkLimitColls();
+}
+
+SIOFrameData::SIOFrameData(sio::buffer_span dataRecord, const sio::record_info& dataInfo, sio::buffer_span tableRecord,
+                           const sio::record_info& tableInfo, std::shared_ptr<const void> owner,
+                           std::vector<std::string> limitColls) :
+    m_recData(dataRecord),
+    m_owner(std::move(owner)),
+    m_dataSize(dataInfo._uncompressed_length),
+    m_tableSize(tableInfo._uncompressed_length),
+    m_limitColls(std::move(limitColls)) {
+  readIdTable(tableRecord);
+  checkLimitColls();
+}
+
+void SIOFrameData::checkLimitColls() const {
   // Assuming here that the idTable only contains the collections that are
   // also available
-  if (!m_limitColls.empty()) {
-    for (const auto& name : m_limitColls) {
-      if (std::ranges::find(m_idTable.names(), name) == m_idTable.names().end()) {
-        throw std::invalid_argument(name + " is not available from Frame");
-      }
+  for (const auto& name : m_limitColls) {
+    if (std::ranges::find(m_idTable.names(), name) == m_idTable.names().end()) {
+      throw std::invalid_argument(name + " is not available from Frame");
     }
   }
 }
@@ -44,6 +74,7 @@ std::optional<podio::CollectionReadBuffers> SIOFrameData::getCollectionBuffers(c
     }
 
     // Mark this block as consumed
+    unpackBlock(index);
     m_availableBlocks[index] = 0;
     return {dynamic_cast<podio::SIOBlock*>(m_blocks[index].get())->getBuffers()};
   }
@@ -53,6 +84,7 @@ std::optional<podio::CollectionReadBuffers> SIOFrameData::getCollectionBuffers(c
 
 std::unique_ptr<podio::GenericParameters> SIOFrameData::getParameters() {
   unpackBuffers();
+  unpackBlock(0);
   m_availableBlocks[0] = 0;
   return std::make_unique<podio::GenericParameters>(std::move(m_parameters));
 }
@@ -80,26 +112,82 @@ void SIOFrameData::unpackBuffers() {
 
   createBlocks();
 
-  sio::zlib_compression compressor;
-  sio::buffer uncBuffer{m_dataSize};
-  compressor.uncompress(m_recBuffer.span(), uncBuffer);
-  sio::api::read_blocks(uncBuffer.span(), m_blocks);
+  // Collections that should not become available do not have to be read at
+  // all (if possible)
+  if (!m_limitColls.empty()) {
+    for (size_t i = 1; i < m_blocks.size(); ++i) {
+      const auto& name = m_idTable.names()[i - 1];
+      if (std::ranges::find(m_limitColls, name) == m_limitColls.end()) {
+        m_availableBlocks[i] = 0;
+      }
+    }
+  }
+
+  if (!m_blockOffsets.empty()) {
+    // Stored blocks are read directly from the record, e.g. from the memory
+    // mapped file. Compressed ones are only decompressed once they are
+    // requested
+    if (m_blocksCompressed || !locateStoredBlocks()) {
+      auto compressedBlocks = std::make_shared<SIOCompressedBlocksBlock>();
+      sio::api::read_blocks(m_recData, {compressedBlocks});
+      m_recBuffer = sio::buffer{std::move(compressedBlocks->data)};
+      m_recData = m_recBuffer.span();
+    }
+  } else {
+    sio::zlib_compression compressor;
+    sio::buffer uncBuffer{m_dataSize};
+    compressor.uncompress(m_recData, uncBuffer);
+    sio::api::read_blocks(uncBuffer.span(), m_blocks);
+    std::ranges::fill(m_unpackedBlocks, 1);
+
+    // In order to save on memory and to not litter the rest of the
+    // implementation with similar checks, we immediately throw away all
+    // collections that should not become available
+    for (size_t i = 1; i < m_blocks.size(); ++i) {
+      if (!m_availableBlocks[i]) {
+        auto buffers = dynamic_cast<SIOBlock*>(m_blocks[i].get())->getBuffers();
+        buffers.deleteBuffers(buffers);
+      }
+    }
+  }
+}
+
+bool SIOFrameData::locateStoredBlocks() {
+  // The stored blocks are the data of the only block of the record. They are
+  // padded such that they end with the record and are preceded by their size
+  const auto size = sio_utils::storedBlocksSize(m_blockOffsets, m_blockSizes);
+  if (size + sizeof(unsigned) > m_recData.size()) {
+    return false;
+  }
+  const auto* start = m_recData.data() + (m_recData.size() - size);
+  unsigned storedSize{0};
+  sio::read_device device(sio::buffer_span{start - sizeof(unsigned), sizeof(unsigned)});
+  device.data(storedSize);
+  if (storedSize != size) {
+    return false;
+  }
+  m_recData = sio::buffer_span{start, size};
+  return true;
+}
 
-  if (m_limitColls.empty()) {
+void SIOFrameData::unpackBlock(size_t index) {
+  if (m_unpackedBlocks[index]) {
     return;
   }
 
-  // In order to save on memory and to not litter the rest of the implementation
-  // with similar checks, we immediately throw away all collections that should
-  // not become available
-  for (size_t i = 1; i < m_blocks.size(); ++i) {
-    const auto name = m_idTable.names()[i - 1];
-    if (std::ranges::find(m_limitColls, name) == m_limitColls.end()) {
-      auto buffers = dynamic_cast<SIOBlock*>(m_blocks[i].get())->getBuffers();
-      buffers.deleteBuffers(buffers);
-      m_availableBlocks[i] = 0;
-    }
+  if (!m_blocksCompressed) {
+    // The data are copied once, straight from the record into the buffers
+    sio::api::read_blocks(sio::buffer_span{m_recData.data() + m_blockOffsets[index], m_blockSizes[index]},
+                          {m_blocks[index]});
+    m_unpackedBlocks[index] = 1;
+    return;
   }
+
+  sio::zlib_compression compressor;
+  sio::buffer uncBuffer{m_blockUncompressedSizes[index]};
+  compressor.uncompress(m_recBuffer.span(m_blockOffsets[index], m_blockSizes[index]), uncBuffer);
+  sio::api::read_blocks(uncBuffer.span(), {m_blocks[index]});
+  m_unpackedBlocks[index] = 1;
 }
 
 void SIOFrameData::createBlocks() {
@@ -116,26 +204,43 @@ void SIOFrameData::createBlocks() {
   }
 
   m_availableBlocks.resize(m_blocks.size(), 1);
+  m_unpackedBlocks.resize(m_blocks.size(), 0);
 }
 
-void SIOFrameData::readIdTable() {
-  sio::buffer uncBuffer{m_tableSize};
-  sio::zlib_compression compressor;
-  compressor.uncompress(m_tableBuffer.span(), uncBuffer);
-
+void SIOFrameData::readIdTable(const sio::buffer_span& table) {
   sio::block_list blocks;
   blocks.emplace_back(std::make_shared<SIOCollectionIDTableBlock>());
+  // Only present if the blocks of the data record are compressed separately
+  auto blockIndex = std::make_shared<SIOCompressedBlockIndexBlock>();
+  blocks.emplace_back(blockIndex);
+  // Only present in files written with newer versions of podio
+  auto collSizes = std::make_shared<SIOCollectionSizeIndexBlock>();
+  blocks.emplace_back(collSizes);
+
+  sio::buffer uncBuffer{m_tableSize};
+  sio::zlib_compression compressor;
+  compressor.uncompress(table, uncBuffer);
   sio::api::read_blocks(uncBuffer.span(), blocks);
 
   auto* idTableBlock = static_cast<SIOCollectionIDTableBlock*>(blocks[0].get());
   m_idTable = idTableBlock->getTable();
   m_typeNames = idTableBlock->getTypeNames();
   m_subsetCollectionBits = idTableBlock->getSubsetCollectionBits();
+  m_blockOffsets = std::move(blockIndex->offsets);
+  m_blockSizes = std::move(blockIndex->compressedSizes);
+  m_blockUncompressedSizes = std::move(blockIndex->uncompressedSizes);
+  m_blocksCompressed = blockIndex->compressed;
+  m_collSizes = sio_utils::makeCollectionSizeIndex(m_idTable.names(), m_typeNames, *collSizes);
+  // Only the collections that become available are part of the index
+  if (!m_limitColls.empty()) {
+    std::erase_if(m_collSizes,
+                  [this](const auto& entry) { return std::ranges::find(m_limitColls, entry.first) == m_limitColls.end(); });
+  }
 }
 
 SIOFrameData::~SIOFrameData() {
   for (size_t i = 1; i < m_blocks.size(); ++i) {
-    if (m_availableBlocks[i]) {
+    if (m_availableBlocks[i] && m_unpackedBlocks[i]) {
       auto buffers = dynamic_cast<SIOBlock*>(m_blocks[i].get())->getBuffers();
       buffers.deleteBuffers(buffers);
     }
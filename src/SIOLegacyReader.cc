@@ -96,33 +96,7 @@ void SIOLegacyReader::readCollectionIDTable() {
 }
 
 bool SIOLegacyReader::readFileTOCRecord() {
-  // Check if there is a dedicated marker at the end of the file that tells us
-  // where the TOC actually starts
-  m_stream.seekg(-sio_helpers::SIOTocInfoSize, std::ios_base::end);
-  uint64_t firstWords{0};
-  m_stream.read(reinterpret_cast<char*>(&firstWords), sizeof(firstWords));
-
-  const uint32_t marker = (firstWords >> 32) & 0xffffffff;
-  if (marker == sio_helpers::SIOTocMarker) {
-    const uint32_t position = firstWords & 0xffffffff;
-    m_stream.seekg(position);
-
-    const auto& [uncBuffer, _] = sio_utils::readRecord(m_stream);
-
-    sio::block_list blocks;
-    auto tocBlock = std::make_shared<SIOFileTOCRecordBlock>();
-    tocBlock->record = &m_tocRecord;
-    blocks.push_back(tocBlock);
-
-    sio::api::read_blocks(uncBuffer.span(), blocks);
-
-    m_stream.seekg(0);
-    return true;
-  }
-
-  m_stream.clear();
-  m_stream.seekg(0);
-  return false;
+  return sio_helpers::readFileTOCRecord(m_stream, m_tocRecord);
 }
 
 std::vector<std::string_view> SIOLegacyReader::getAvailableCategories() const {
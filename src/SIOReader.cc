@@ -1,4 +1,5 @@
 #include "podio/SIOReader.h"
+#include "podio/utilities/ThreadPool.h"
 
 #include "sioUtils.h"
 
@@ -10,20 +11,86 @@
 
 namespace podio {
 
+namespace {
+  /// Read the table and the data record of one entry starting at the given position
+  std::unique_ptr<SIOFrameData> readFrameData(sio::ifstream& stream, SIOFileTOCRecord::PositionType recordPos,
+                                              const std::vector<std::string>& collsToRead) {
+    stream.seekg(recordPos);
+
+    auto [tableBuffer, tableInfo] = sio_utils::readRecord(stream, false);
+    auto [dataBuffer, dataInfo] = sio_utils::readRecord(stream, false);
+
+    return std::make_unique<SIOFrameData>(std::move(dataBuffer), dataInfo, std::move(tableBuffer), tableInfo,
+                                          collsToRead);
+  }
+
+  /// Get the table and the data record of one entry starting at the given
+  /// position directly from the memory mapped file
+  std::unique_ptr<SIOFrameData> mapFrameData(const std::shared_ptr<const sio_utils::MappedFile>& mapping,
+                                             SIOFileTOCRecord::PositionType recordPos,
+                                             const std::vector<std::string>& collsToRead) {
+    const auto [tableInfo, tableRecord] = sio_utils::mapRecord(*mapping, recordPos);
+    const auto [dataInfo, dataRecord] = sio_utils::mapRecord(*mapping, tableInfo._file_end);
+
+    return std::make_unique<SIOFrameData>(dataRecord, dataInfo, tableRecord, tableInfo, mapping, collsToRead);
+  }
+} // namespace
+
 SIOReader::SIOReader() {
   auto& libLoader [[maybe_unused]] = SIOBlockLibraryLoader::instance();
 }
 
 void SIOReader::openFile(const std::string& filename) {
-  m_stream.open(filename, std::ios::binary);
-  if (!m_stream.is_open()) {
-    throw std::runtime_error("File " + filename + " couldn't be opened");
+  openFiles({filename});
+}
+
+void SIOReader::openFiles(const std::vector<std::string>& filenames) {
+  m_files.clear();
+  m_nameCtr.clear();
+  m_files.reserve(filenames.size());
+
+  for (const auto& filename : filenames) {
+    auto& file = m_files.emplace_back(std::make_unique<FileInfo>());
+    file->filename = filename;
+    file->stream.open(filename, std::ios::binary);
+    if (!file->stream.is_open()) {
+      throw std::runtime_error("File " + filename + " couldn't be opened");
+    }
+
+    // NOTE: reading TOC record first because that jumps back to the start of the file!
+    sio_helpers::readFileTOCRecord(file->stream, file->toc);
+    readPodioHeader(*file);
+    if (m_useMemoryMap) {
+      file->mapping = std::make_shared<const sio_utils::MappedFile>(filename);
+    }
   }
 
-  // NOTE: reading TOC record first because that jumps back to the start of the file!
-  readFileTOCRecord();
-  readPodioHeader();
-  readEDMDefinitions(); // Potentially could do this lazily
+  if (!m_files.empty()) {
+    m_fileVersion = m_files[0]->fileVersion;
+    readEDMDefinitions(*m_files[0]); // Potentially could do this lazily
+  }
+}
+
+void SIOReader::enableMemoryMap(bool enable) {
+  m_useMemoryMap = enable;
+  for (auto& file : m_files) {
+    if (!enable) {
+      file->mapping.reset();
+    } else if (!file->mapping) {
+      file->mapping = std::make_shared<const sio_utils::MappedFile>(file->filename);
+    }
+  }
+}
+
+std::optional<std::pair<size_t, unsigned>> SIOReader::locateEntry(const std::string& name, unsigned entry) const {
+  for (size_t i = 0; i < m_files.size(); ++i) {
+    const auto nEntries = m_files[i]->toc.getNRecords(name);
+    if (entry < nEntries) {
+      return std::make_pair(i, entry);
+    }
+    entry -= nEntries;
+  }
+  return std::nullopt;
 }
 
 std::unique_ptr<SIOFrameData> SIOReader::readNextEntry(const std::string& name,
@@ -33,19 +100,22 @@ std::unique_ptr<SIOFrameData> SIOReader::readNextEntry(const std::string& name,
   //
   // NOTE: exploiting the fact that the operator[] of a map will create a
   // default initialized entry for us if not present yet
-  const auto recordPos = m_tocRecord.getPosition(name, m_nameCtr[name]);
+  const auto location = locateEntry(name, m_nameCtr[name]);
+  if (!location) {
+    return nullptr;
+  }
+  auto& file = *m_files[location->first];
+  const auto recordPos = file.toc.getPosition(name, location->second);
   if (recordPos == 0) {
     return nullptr;
   }
-  m_stream.seekg(recordPos);
-
-  auto [tableBuffer, tableInfo] = sio_utils::readRecord(m_stream, false);
-  auto [dataBuffer, dataInfo] = sio_utils::readRecord(m_stream, false);
 
+  auto frameData = file.mapping ? mapFrameData(file.mapping, recordPos, collsToRead)
+                                : readFrameData(file.stream, recordPos, collsToRead);
+  m_fileVersion = file.fileVersion;
   m_nameCtr[name]++;
 
-  return std::make_unique<SIOFrameData>(std::move(dataBuffer), dataInfo._uncompressed_length, std::move(tableBuffer),
-                                        tableInfo._uncompressed_length, collsToRead);
+  return frameData;
 }
 
 std::unique_ptr<SIOFrameData> SIOReader::readEntry(const std::string& name, const unsigned entry,
@@ -56,10 +126,109 @@ std::unique_ptr<SIOFrameData> SIOReader::readEntry(const std::string& name, cons
   return readNextEntry(name, collsToRead);
 }
 
+std::vector<std::unique_ptr<SIOFrameData>> SIOReader::readEntries(const std::string& name, const unsigned first,
+                                                                  const unsigned count,
+                                                                  const std::vector<std::string>& collsToRead,
+                                                                  const unsigned nThreads) {
+  // Look up where all the requested (and available) entries are first
+  std::vector<std::pair<size_t, SIOFileTOCRecord::PositionType>> records;
+  records.reserve(count);
+  for (unsigned entry = first; entry < first + count; ++entry) {
+    const auto location = locateEntry(name, entry);
+    if (!location) {
+      break;
+    }
+    records.emplace_back(location->first, m_files[location->first]->toc.getPosition(name, location->second));
+  }
+
+  std::vector<std::unique_ptr<SIOFrameData>> entries(records.size());
+  if (records.empty()) {
+    return entries;
+  }
+
+  // Split the entries into contiguous chunks, one per thread of the (shared)
+  // pool. Each chunk reads via its own streams, so that the chunks can be read
+  // concurrently. The first chunk uses the main streams, the others use
+  // additional streams that are opened on first use and then kept open
+  auto& pool = utils::sharedThreadPool(nThreads);
+  const auto nChunks = std::min<size_t>(pool.size(), records.size());
+  for (auto& file : m_files) {
+    if (file->chunkStreams.size() < nChunks - 1) {
+      file->chunkStreams.resize(nChunks - 1);
+    }
+  }
+  pool.parallelFor(nChunks, [&](size_t chunk) {
+    auto getStream = [&](size_t iFile) -> sio::ifstream& {
+      auto& file = *m_files[iFile];
+      if (chunk == 0) {
+        return file.stream;
+      }
+      auto& stream = file.chunkStreams[chunk - 1];
+      if (!stream.is_open()) {
+        stream.open(file.filename, std::ios::binary);
+        if (!stream.is_open()) {
+          throw std::runtime_error("File " + file.filename + " couldn't be opened");
+        }
+      }
+      return stream;
+    };
+
+    const auto begin = chunk * records.size() / nChunks;
+    const auto end = (chunk + 1) * records.size() / nChunks;
+    for (auto i = begin; i < end; ++i) {
+      const auto [iFile, recordPos] = records[i];
+      // The mapping can be shared by all threads
+      const auto& mapping = m_files[iFile]->mapping;
+      entries[i] = mapping ? mapFrameData(mapping, recordPos, collsToRead)
+                           : readFrameData(getStream(iFile), recordPos, collsToRead);
+    }
+  });
+
+  m_fileVersion = m_files[records.back().first]->fileVersion;
+  m_nameCtr[name] = first + records.size();
+
+  return entries;
+}
+
+std::optional<podio::CollectionSizeIndex> SIOReader::getCollectionSizes(const std::string& name,
+                                                                         const unsigned entry) {
+  const auto location = locateEntry(name, entry);
+  if (!location) {
+    return std::nullopt;
+  }
+  auto& file = *m_files[location->first];
+  const auto recordPos = file.toc.getPosition(name, location->second);
+  if (recordPos == 0) {
+    return std::nullopt;
+  }
+
+  // Only the table record is necessary for this
+  file.stream.seekg(recordPos);
+  auto [tableBuffer, tableInfo] = sio_utils::readRecord(file.stream, false);
+
+  auto idTableBlock = std::make_shared<SIOCollectionIDTableBlock>();
+  auto collSizes = std::make_shared<SIOCollectionSizeIndexBlock>();
+  sio::block_list blocks{idTableBlock, collSizes};
+  sio::buffer uncBuffer{tableInfo._uncompressed_length};
+  sio::zlib_compression compressor;
+  compressor.uncompress(tableBuffer.span(0, tableInfo._data_length), uncBuffer);
+  sio::api::read_blocks(uncBuffer.span(), blocks);
+
+  auto index = sio_utils::makeCollectionSizeIndex(idTableBlock->getTable().names(), idTableBlock->getTypeNames(),
+                                                  *collSizes);
+  if (index.empty() && !idTableBlock->getTypeNames().empty()) {
+    return std::nullopt;
+  }
+  return index;
+}
+
 std::vector<std::string_view> SIOReader::getAvailableCategories() const {
+  if (m_files.empty()) {
+    return {};
+  }
   // Filter the available records from the TOC to remove records that are
   // stored, but use reserved record names for podio meta data
-  auto recordNames = m_tocRecord.getRecordNames();
+  auto recordNames = m_files[0]->toc.getRecordNames();
   recordNames.erase(std::remove_if(recordNames.begin(), recordNames.end(),
                                    [](const auto& elem) { return elem == sio_helpers::SIOEDMDefinitionName; }),
                     recordNames.end());
@@ -67,58 +236,32 @@ std::vector<std::string_view> SIOReader::getAvailableCategories() const {
 }
 
 unsigned SIOReader::getEntries(const std::string& name) const {
-  return m_tocRecord.getNRecords(name);
-}
-
-bool SIOReader::readFileTOCRecord() {
-  // Check if there is a dedicated marker at the end of the file that tells us
-  // where the TOC actually starts
-  m_stream.seekg(-sio_helpers::SIOTocInfoSize, std::ios_base::end);
-  uint64_t firstWords{0};
-  m_stream.read(reinterpret_cast<char*>(&firstWords), sizeof(firstWords));
-
-  const uint32_t marker = (firstWords >> 32) & 0xffffffff;
-  if (marker == sio_helpers::SIOTocMarker) {
-    const uint32_t position = firstWords & 0xffffffff;
-    m_stream.seekg(position);
-
-    const auto& [uncBuffer, _] = sio_utils::readRecord(m_stream);
-
-    sio::block_list blocks;
-    auto tocBlock = std::make_shared<SIOFileTOCRecordBlock>();
-    tocBlock->record = &m_tocRecord;
-    blocks.push_back(tocBlock);
-
-    sio::api::read_blocks(uncBuffer.span(), blocks);
-
-    m_stream.seekg(0);
-    return true;
+  unsigned nEntries = 0;
+  for (const auto& file : m_files) {
+    nEntries += file->toc.getNRecords(name);
   }
-
-  m_stream.clear();
-  m_stream.seekg(0);
-  return false;
+  return nEntries;
 }
 
-void SIOReader::readPodioHeader() {
-  const auto& [buffer, _] = sio_utils::readRecord(m_stream, false, sizeof(podio::version::Version));
+void SIOReader::readPodioHeader(FileInfo& file) {
+  const auto& [buffer, _] = sio_utils::readRecord(file.stream, false, sizeof(podio::version::Version));
 
   sio::block_list blocks;
   blocks.emplace_back(std::make_shared<SIOVersionBlock>());
   sio::api::read_blocks(buffer.span(), blocks);
 
-  m_fileVersion = static_cast<SIOVersionBlock*>(blocks[0].get())->version;
+  file.fileVersion = static_cast<SIOVersionBlock*>(blocks[0].get())->version;
 }
 
-void SIOReader::readEDMDefinitions() {
-  const auto recordPos = m_tocRecord.getPosition(sio_helpers::SIOEDMDefinitionName);
+void SIOReader::readEDMDefinitions(FileInfo& file) {
+  const auto recordPos = file.toc.getPosition(sio_helpers::SIOEDMDefinitionName);
   if (recordPos == 0) {
     // No EDM definitions found
     return;
   }
-  m_stream.seekg(recordPos);
+  file.stream.seekg(recordPos);
 
-  const auto& [buffer, _] = sio_utils::readRecord(m_stream);
+  const auto& [buffer, _] = sio_utils::readRecord(file.stream);
 
   sio::block_list blocks;
   blocks.emplace_back(std::make_shared<podio::SIOMapBlock<std::string, std::string>>());
@@ -10,7 +10,16 @@
 
 namespace podio {
 
-SIOWriter::SIOWriter(const std::string& filename) {
+SIOWriter::SIOWriter(const std::string& filename, const WriterOptions& options) : m_options(options) {
+  // Make sure that all requested codecs are supported before creating a file
+  sio_utils::getCompressionLevel(m_options.compression);
+  for (const auto& [_, settings] : m_options.categoryCompression) {
+    sio_utils::getCompressionLevel(settings);
+  }
+  if (utils::defaultNumThreads(m_options.compressionThreads) > 1) {
+    m_compressionPool = std::make_unique<utils::ThreadPool>(m_options.compressionThreads);
+  }
+
   m_stream.open(filename, std::ios::binary);
   if (!m_stream.is_open()) {
     SIO_THROW(sio::error_code::not_open, "Couldn't open output stream '" + filename + "'");
@@ -36,11 +45,19 @@ void SIOWriter::writeFrame(const podio::Frame& frame, const std::string& categor
 
 void SIOWriter::writeFrame(const podio::Frame& frame, const std::string& category,
                            const std::vector<std::string>& collsToWrite) {
+  writeEncodedFrame(encodeFrame(frame, category, collsToWrite));
+}
+
+SIOWriter::EncodedFrame SIOWriter::encodeFrame(const podio::Frame& frame, const std::string& category,
+                                               const std::vector<std::string>& collsToWrite) const {
+  const auto compressionLevel = sio_utils::getCompressionLevel(m_options.getCompression(category));
+
+  DatamodelDefinitionCollector datamodelCollector{};
   std::vector<sio_utils::StoreCollection> collections;
   collections.reserve(collsToWrite.size());
   for (const auto& name : collsToWrite) {
     collections.emplace_back(name, frame.getCollectionForWrite(name));
-    m_datamodelCollector.registerDatamodelDefinition(collections.back().second, name);
+    datamodelCollector.registerDatamodelDefinition(collections.back().second, name);
   }
 
   // Write necessary metadata and the actual data into two different records.
@@ -48,10 +65,28 @@ void SIOWriter::writeFrame(const podio::Frame& frame, const std::string& categor
   // information is contained within the record.
   sio::block_list tableBlocks;
   tableBlocks.emplace_back(sio_utils::createCollIDBlock(collections, frame.getCollectionIDTableForWrite()));
-  m_tocRecord.addRecord(category, sio_utils::writeRecord(tableBlocks, category + "_HEADER", m_stream));
+  tableBlocks.emplace_back(sio_utils::createCollSizeIndexBlock(collections));
 
   const auto blocks = sio_utils::createBlocks(collections, frame.getParameters());
-  sio_utils::writeRecord(blocks, category, m_stream);
+  // Every block of the data record is compressed on its own, such that readers
+  // only have to decompress the collections they actually need. The index of
+  // the blocks is stored in the table record. With a compression level of 0
+  // the blocks are stored as they are, such that readers can deserialize them
+  // directly from the record. The (small) table record is always a zlib stream
+  auto blockIndex = std::make_shared<SIOCompressedBlockIndexBlock>();
+  auto data = sio_utils::encodeCompressedBlocks(blocks, category, *blockIndex, sio::mbyte, compressionLevel,
+                                                m_compressionPool.get());
+  tableBlocks.emplace_back(std::move(blockIndex));
+
+  auto table = sio_utils::encodeRecord(tableBlocks, category + "_HEADER", sio::mbyte, true, compressionLevel);
+
+  return {category, std::move(table), std::move(data), std::move(datamodelCollector)};
+}
+
+void SIOWriter::writeEncodedFrame(EncodedFrame&& frame) {
+  m_datamodelCollector.merge(frame.datamodelCollector);
+  m_tocRecord.addRecord(frame.category, sio_utils::writeEncodedRecord(frame.table, m_stream));
+  sio_utils::writeEncodedRecord(frame.data, m_stream);
 }
 
 void SIOWriter::finish() {
@@ -75,16 +110,7 @@ void SIOWriter::finish() {
 
   m_tocRecord.addRecord(sio_helpers::SIOEDMDefinitionName, sio_utils::writeRecord(blocks, "EDMDefinitions", m_stream));
 
-  blocks.clear();
-  blocks.emplace_back(std::make_shared<SIOFileTOCRecordBlock>(&m_tocRecord));
-
-  auto tocStartPos = sio_utils::writeRecord(blocks, sio_helpers::SIOTocRecordName, m_stream);
-
-  // Now that we know the position of the TOC Record, put this information
-  // into a final marker that can be identified and interpreted when reading
-  // again
-  uint64_t finalWords = (((uint64_t)sio_helpers::SIOTocMarker) << 32) | ((uint64_t)tocStartPos & 0xffffffff);
-  m_stream.write(reinterpret_cast<char*>(&finalWords), sizeof(finalWords));
+  sio_helpers::writeFileTOCRecord(m_stream, m_tocRecord);
 
   m_stream.close();
 
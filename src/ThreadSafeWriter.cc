@@ -0,0 +1,93 @@
+#include "podio/ThreadSafeWriter.h"
+
+#include "TROOT.h"
+
+#include <stdexcept>
+
+namespace podio {
+
+ThreadSafeWriter::ThreadSafeWriter(std::unique_ptr<WriterConcept> writer) : m_self(std::move(writer)) {
+  // Frames are written from several threads, while other threads might be
+  // reading or writing other files at the same time
+  ROOT::EnableThreadSafety();
+}
+
+ThreadSafeWriter::Turn::Turn(ThreadSafeWriter& writer, const std::string& category,
+                             std::optional<uint64_t> sequence) :
+    m_lock(writer.waitForTurn(category, sequence)), m_release(writer, category, sequence) {
+  // If this throws, m_release still lets the next Frame through
+  writer.checkNotFinished();
+}
+
+ThreadSafeWriter::Turn::Release::Release(ThreadSafeWriter& writer, const std::string& category,
+                                         std::optional<uint64_t> sequence) :
+    m_writer(writer), m_category(category), m_sequence(sequence) {
+}
+
+ThreadSafeWriter::Turn::Release::~Release() {
+  if (m_sequence) {
+    // Called while the lock of the Turn is still held
+    m_writer.m_nextSequence[m_category]++;
+    m_writer.m_cv.notify_all();
+  }
+}
+
+std::unique_lock<std::mutex> ThreadSafeWriter::waitForTurn(const std::string& category,
+                                                           std::optional<uint64_t> sequence) {
+  std::unique_lock lock{m_mtx};
+  if (sequence) {
+    m_cv.wait(lock, [&]() { return m_nextSequence[category] == sequence.value(); });
+  }
+  return lock;
+}
+
+void ThreadSafeWriter::skipTurn(const std::string& category, std::optional<uint64_t> sequence) noexcept {
+  if (!sequence) {
+    return;
+  }
+  auto lock = waitForTurn(category, sequence);
+  m_nextSequence[category]++;
+  lock.unlock();
+  m_cv.notify_all();
+}
+
+ThreadSafeWriter::~ThreadSafeWriter() {
+  if (!m_finished) {
+    finish();
+  }
+}
+
+void ThreadSafeWriter::writeFrame(const podio::Frame& frame, const std::string& category) {
+  writeFrame(frame, category, frame.getAvailableCollections());
+}
+
+void ThreadSafeWriter::writeFrame(const podio::Frame& frame, const std::string& category,
+                                  const std::vector<std::string>& collsToWrite) {
+  m_self->writeFrame(frame, category, collsToWrite, *this, std::nullopt);
+}
+
+void ThreadSafeWriter::writeFrame(const podio::Frame& frame, const std::string& category, uint64_t sequence) {
+  writeFrame(frame, category, frame.getAvailableCollections(), sequence);
+}
+
+void ThreadSafeWriter::writeFrame(const podio::Frame& frame, const std::string& category,
+                                  const std::vector<std::string>& collsToWrite, uint64_t sequence) {
+  m_self->writeFrame(frame, category, collsToWrite, *this, sequence);
+}
+
+void ThreadSafeWriter::finish() {
+  std::lock_guard lock{m_mtx};
+  if (m_finished) {
+    return;
+  }
+  m_self->finish();
+  m_finished = true;
+}
+
+void ThreadSafeWriter::checkNotFinished() {
+  if (m_finished) {
+    throw std::runtime_error("Cannot write Frames with a ThreadSafeWriter that has already been finished");
+  }
+}
+
+} // namespace podio
@@ -1,4 +1,5 @@
 #include "podio/Writer.h"
+#include "podio/ThreadSafeWriter.h"
 
 #include "podio/ROOTWriter.h"
 #if PODIO_ENABLE_RNTUPLE
@@ -12,33 +13,47 @@
 
 namespace podio {
 
-Writer makeWriter(const std::string& filename, const std::string& type) {
+namespace {
+  /// Create the low level writer for the desired backend and wrap it into the
+  /// desired type erased writer
+  template <typename WriterT>
+  WriterT makeWriterImpl(const std::string& filename, const std::string& type, const WriterOptions& options) {
 
-  auto endsWith = [](const std::string& str, const std::string& suffix) {
-    return str.size() >= suffix.size() && 0 == str.compare(str.size() - suffix.size(), suffix.size(), suffix);
-  };
+    auto endsWith = [](const std::string& str, const std::string& suffix) {
+      return str.size() >= suffix.size() && 0 == str.compare(str.size() - suffix.size(), suffix.size(), suffix);
+    };
 
-  auto lower = [](std::string str) {
-    std::transform(str.begin(), str.end(), str.begin(), [](unsigned char c) { return std::tolower(c); });
-    return str;
-  };
+    auto lower = [](std::string str) {
+      std::transform(str.begin(), str.end(), str.begin(), [](unsigned char c) { return std::tolower(c); });
+      return str;
+    };
 
-  if ((type == "default" && endsWith(filename, ".root")) || lower(type) == "root") {
-    return Writer{std::make_unique<ROOTWriter>(filename)};
-  } else if (lower(type) == "rntuple") {
+    if ((type == "default" && endsWith(filename, ".root")) || lower(type) == "root") {
+      return WriterT{std::make_unique<ROOTWriter>(filename, options)};
+    } else if (lower(type) == "rntuple") {
 #if PODIO_ENABLE_RNTUPLE
-    return Writer{std::make_unique<RNTupleWriter>(filename)};
+      return WriterT{std::make_unique<RNTupleWriter>(filename, options)};
 #else
-    throw std::runtime_error("ROOT RNTuple writer not available. Please recompile with ROOT RNTuple support.");
+      throw std::runtime_error("ROOT RNTuple writer not available. Please recompile with ROOT RNTuple support.");
 #endif
-  } else if (endsWith(filename, ".sio")) {
+    } else if (endsWith(filename, ".sio")) {
 #if PODIO_ENABLE_SIO
-    return Writer{std::make_unique<SIOWriter>(filename)};
+      return WriterT{std::make_unique<SIOWriter>(filename, options)};
 #else
-    throw std::runtime_error("SIO writer not available. Please recompile with SIO support.");
+      throw std::runtime_error("SIO writer not available. Please recompile with SIO support.");
 #endif
+    }
+    throw std::runtime_error("Unknown file type for file " + filename + " with type " + type);
   }
-  throw std::runtime_error("Unknown file type for file " + filename + " with type " + type);
+} // namespace
+
+Writer makeWriter(const std::string& filename, const std::string& type, const WriterOptions& options) {
+  return makeWriterImpl<Writer>(filename, type, options);
+}
+
+ThreadSafeWriter makeThreadSafeWriter(const std::string& filename, const std::string& type,
+                                      const WriterOptions& options) {
+  return makeWriterImpl<ThreadSafeWriter>(filename, type, options);
 }
 
 } // namespace podio
@@ -1,10 +1,13 @@
 #ifndef PODIO_ROOT_UTILS_H // NOLINT(llvm-header-guard): internal headers confuse clang-tidy
 #define PODIO_ROOT_UTILS_H // NOLINT(llvm-header-guard): internal headers confuse clang-tidy
 
+#include "podio/CollectionBuffers.h"
 #include "podio/CollectionIDTable.h"
+#include "podio/WriterOptions.h"
 #include "podio/utilities/RootHelpers.h"
 #include "podio/utilities/TypeHelpers.h"
 
+#include "Compression.h"
 #include "TBranch.h"
 #include "TTree.h"
 
@@ -12,6 +15,7 @@
 #include <cctype>
 #include <iostream>
 #include <iterator>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <string_view>
@@ -45,6 +49,13 @@ constexpr static auto floatValueName = "GPFloatValues";
 constexpr static auto doubleValueName = "GPDoubleValues";
 constexpr static auto stringValueName = "GPStringValues";
 
+/**
+ * Names of the branches / fields with the collection size index, i.e. the
+ * number of elements and the size of the buffers of each collection of an entry
+ */
+constexpr static auto collElementsName = "CollectionElements";
+constexpr static auto collBytesName = "CollectionBytes";
+
 /**
  * Get the name of the key depending on the type
  */
@@ -165,6 +176,16 @@ inline std::string collInfoName(const std::string& category) {
   return category + suffix;
 }
 
+/**
+ * Name of the branch (resp. field) for storing the value types of the
+ * collections of a given category in the meta data, in the same order as the
+ * collection info. These are necessary for the collection size index
+ */
+inline std::string valueTypesName(const std::string& category) {
+  constexpr static auto suffix = "___CollectionValueTypes";
+  return category + suffix;
+}
+
 // Workaround slow branch retrieval for 6.22/06 performance degradation
 // see: https://root-forum.cern.ch/t/serious-degradation-of-i-o-performance-from-6-20-04-to-6-22-06/43584/10
 template <class Tree>
@@ -235,6 +256,44 @@ inline void setCollectionAddresses(const BufferT& collBuffers, const CollectionB
   }
 }
 
+/**
+ * Set the branch addresses for reading into the passed buffers. All addresses
+ * are passed as pointers to the pointers of the buffers, such that ROOT reads
+ * directly into the existing (and potentially recycled) vectors.
+ */
+inline void setReadBufferAddresses(podio::CollectionReadBuffers& collBuffers, const CollectionBranches& branches) {
+  if (collBuffers.data) {
+    branches.data->SetAddress(&collBuffers.data);
+  }
+
+  if (auto refCollections = collBuffers.references) {
+    for (size_t i = 0; i < refCollections->size(); ++i) {
+      branches.refs[i]->SetAddress(&(*refCollections)[i]);
+    }
+  }
+
+  if (auto vecMembers = collBuffers.vectorMembers) {
+    for (size_t i = 0; i < vecMembers->size(); ++i) {
+      branches.vecs[i]->SetAddress(&(*vecMembers)[i].second);
+    }
+  }
+}
+
+/**
+ * Set the compression settings for all the branches of a collection
+ */
+inline void setCompressionSettings(const CollectionBranches& branches, int settings) {
+  if (branches.data) {
+    branches.data->SetCompressionSettings(settings);
+  }
+  for (auto* branch : branches.refs) {
+    branch->SetCompressionSettings(settings);
+  }
+  for (auto* branch : branches.vecs) {
+    branch->SetCompressionSettings(settings);
+  }
+}
+
 inline void readBranchesData(const CollectionBranches& branches, Long64_t entry) {
   // Read all data
   if (branches.data) {
@@ -380,6 +439,27 @@ inline std::string getInconsistentCollsMsg(const std::vector<std::string>& exist
   return sstr.str();
 }
 
+/**
+ * Translate the passed compression settings into the ROOT compression settings.
+ * Returns an empty optional if the ROOT defaults should be used
+ */
+inline std::optional<int> getCompressionSettings(const podio::CompressionSettings& settings) {
+  using Algorithm = ROOT::RCompressionSetting::EAlgorithm;
+  switch (settings.codec) {
+  case CompressionCodec::None:
+    // ROOT interprets a compression level of 0 as uncompressed
+    return 0;
+  case CompressionCodec::Zlib:
+    return ROOT::CompressionSettings(Algorithm::kZLIB, settings.getLevel());
+  case CompressionCodec::LZ4:
+    return ROOT::CompressionSettings(Algorithm::kLZ4, settings.getLevel());
+  case CompressionCodec::ZSTD:
+    return ROOT::CompressionSettings(Algorithm::kZSTD, settings.getLevel());
+  default:
+    return std::nullopt;
+  }
+}
+
 } // namespace podio::root_utils
 
 #endif
@@ -2,18 +2,52 @@
 #define PODIO_SIO_UTILS_H // NOLINT(llvm-header-guard): internal headers confuse clang-tidy
 
 #include "podio/CollectionBase.h"
+#include "podio/CollectionSizeIndex.h"
 #include "podio/GenericParameters.h"
 #include "podio/SIOBlock.h"
+#include "podio/SIOWriter.h"
+#include "podio/WriterOptions.h"
+#include "podio/utilities/ThreadPool.h"
 
 #include <sio/api.h>
 #include <sio/compression/zlib.h>
 #include <sio/definitions.h>
+#include <sio/io_device.h>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 namespace podio {
 namespace sio_utils {
+  /// The zlib compression level that is used if nothing else is requested
+  constexpr int defaultCompressionLevel = 6; // Z_DEFAULT_COMPRESSION==6
+
+  /// Get the zlib compression level to use for the passed compression settings.
+  ///
+  /// A level of 0 stores the blocks of Frame data records without compressing
+  /// them, such that they can be read directly from the record
+  ///
+  /// @throws std::invalid_argument for codecs other than zlib
+  inline int getCompressionLevel(const podio::CompressionSettings& settings) {
+    switch (settings.codec) {
+    case CompressionCodec::Default:
+    case CompressionCodec::Zlib:
+    case CompressionCodec::None:
+      return settings.getLevel();
+    default:
+      throw std::invalid_argument("The SIO backend only supports zlib compression");
+    }
+  }
+
   /// Read the record into a buffer and potentially uncompress it
   inline std::pair<sio::buffer, sio::record_info> readRecord(sio::ifstream& stream, bool decompress = true,
                                                              std::size_t initBufferSize = sio::mbyte) {
@@ -33,6 +67,79 @@ namespace sio_utils {
     return std::make_pair(std::move(recBuffer), recInfo);
   }
 
+  /// A read-only memory mapping of a complete file
+  class MappedFile {
+  public:
+    /// Map the file with the given name into memory
+    ///
+    /// @throws std::runtime_error if the file cannot be opened or mapped
+    explicit MappedFile(const std::string& filename) {
+      const auto fd = ::open(filename.c_str(), O_RDONLY);
+      if (fd < 0) {
+        throw std::runtime_error("File " + filename + " couldn't be opened");
+      }
+      struct stat fileStat {};
+      if (::fstat(fd, &fileStat) == 0 && fileStat.st_size > 0) {
+        m_size = static_cast<std::size_t>(fileStat.st_size);
+        m_data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      }
+      ::close(fd);
+      if (m_data == MAP_FAILED || m_data == nullptr) {
+        throw std::runtime_error("File " + filename + " couldn't be mapped into memory");
+      }
+    }
+
+    ~MappedFile() {
+      ::munmap(m_data, m_size);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+    /// Get the bytes starting at the given position
+    ///
+    /// @throws std::out_of_range if the requested range is not in the file
+    sio::buffer_span span(std::size_t pos, std::size_t count) const {
+      if (pos > m_size || count > m_size - pos) {
+        throw std::out_of_range("Requested bytes are beyond the end of the mapped file");
+      }
+      return {static_cast<const sio::byte*>(m_data) + pos, count};
+    }
+
+  private:
+    void* m_data{nullptr};
+    std::size_t m_size{0};
+  };
+
+  /// Decode the header of the record starting at the given position of a
+  /// mapped file and get the record data without copying it.
+  ///
+  /// The header is decoded in the same way as sio::api::read_record_info does
+  /// when reading from a stream.
+  inline std::pair<sio::record_info, sio::buffer_span> mapRecord(const MappedFile& file, std::size_t pos) {
+    // The part of the header that is necessary here, i.e. everything up to the
+    // length of the record name
+    constexpr std::size_t fixedHeaderLength = 5 * sizeof(unsigned int);
+
+    sio::record_info recInfo;
+    recInfo._file_start = pos;
+    sio::read_device device(file.span(pos, fixedHeaderLength));
+    unsigned int marker{0};
+    device.data(recInfo._header_length);
+    device.data(marker);
+    if (marker != sio::record_marker) {
+      throw std::runtime_error("No SIO record found at position " + std::to_string(pos));
+    }
+    device.data(recInfo._options);
+    device.data(recInfo._data_length);
+    device.data(recInfo._uncompressed_length);
+    recInfo._file_end = pos + recInfo._header_length + recInfo._data_length;
+
+    return {recInfo, file.span(pos + recInfo._header_length, recInfo._data_length)};
+  }
+
   using StoreCollection = std::pair<const std::string&, const podio::CollectionBase*>;
 
   /// Create the collection ID block from the passed collections
@@ -60,6 +167,36 @@ namespace sio_utils {
                                                        std::move(subsetColl));
   }
 
+  /// Create the collection size index block from the passed collections
+  inline std::shared_ptr<SIOCollectionSizeIndexBlock>
+  createCollSizeIndexBlock(const std::vector<StoreCollection>& collections) {
+    auto block = std::make_shared<SIOCollectionSizeIndexBlock>();
+    block->elements.reserve(collections.size());
+    block->bytes.reserve(collections.size());
+    for (const auto& [_, coll] : collections) {
+      block->elements.emplace_back(coll->size());
+      // TODO: get rid of const_cast
+      block->bytes.emplace_back(const_cast<podio::CollectionBase*>(coll)->getBuffers().nBytes);
+    }
+    return block;
+  }
+
+  /// Create the collection size index from the contents of the table record
+  /// of a Frame. Returns an empty index if the table record does not have one
+  inline podio::CollectionSizeIndex makeCollectionSizeIndex(const std::vector<std::string>& names,
+                                                            const std::vector<std::string>& types,
+                                                            const SIOCollectionSizeIndexBlock& sizes) {
+    podio::CollectionSizeIndex index{};
+    if (sizes.elements.size() != names.size() || sizes.bytes.size() != names.size() || types.size() != names.size()) {
+      return index;
+    }
+    index.reserve(names.size());
+    for (size_t i = 0; i < names.size(); ++i) {
+      index.emplace(names[i], CollectionSizeInfo{types[i], sizes.elements[i], sizes.bytes[i]});
+    }
+    return index;
+  }
+
   /// Create all blocks to store the passed collections and parameters into a record
   inline sio::block_list createBlocks(const std::vector<StoreCollection>& collections,
                                       const podio::GenericParameters& parameters) {
@@ -78,26 +215,120 @@ namespace sio_utils {
     return blocks;
   }
 
-  /// Write the passed record and return where it starts in the file
-  inline sio::ifstream::pos_type writeRecord(const sio::block_list& blocks, const std::string& recordName,
-                                             sio::ofstream& stream, std::size_t initBufferSize = sio::mbyte,
-                                             bool compress = true) {
-    auto buffer = sio::buffer{initBufferSize};
-    auto recInfo = sio::api::write_record(recordName, buffer, blocks, 0);
+  /// Write the passed blocks into a record in memory and potentially compress
+  /// it. This does not touch any file and can be done concurrently for
+  /// different records
+  inline SIOEncodedRecord encodeRecord(const sio::block_list& blocks, const std::string& recordName,
+                                       std::size_t initBufferSize = sio::mbyte, bool compress = true,
+                                       int compressionLevel = defaultCompressionLevel) {
+    auto record = SIOEncodedRecord{{}, sio::buffer{initBufferSize}, std::nullopt};
+    record.info = sio::api::write_record(recordName, record.buffer, blocks, 0);
 
     if (compress) {
       // use zlib to compress the record into another buffer
       sio::zlib_compression compressor;
-      compressor.set_level(6); // Z_DEFAULT_COMPRESSION==6
-      auto comBuffer = sio::buffer{initBufferSize};
-      sio::api::compress_record(recInfo, buffer, comBuffer, compressor);
+      compressor.set_level(compressionLevel);
+      record.compressed.emplace(initBufferSize);
+      sio::api::compress_record(record.info, record.buffer, record.compressed.value(), compressor);
+    }
+
+    return record;
+  }
+
+  /// Get the size of the data of the SIOCompressedBlocksBlock for blocks that
+  /// are stored without compression, including the padding
+  inline std::size_t storedBlocksSize(const std::vector<uint64_t>& offsets, const std::vector<uint32_t>& sizes) {
+    if (offsets.empty()) {
+      return 0;
+    }
+    return (offsets.back() + sizes.back() + 3) & ~std::size_t{3};
+  }
+
+  /// Write the passed blocks into a record in memory, where every block is
+  /// compressed on its own. The index that is necessary for locating the single
+  /// blocks again is filled into the passed index block, which has to be stored
+  /// in the table record. The record itself is not compressed any further.
+  ///
+  /// With a compression level of 0 the blocks are stored as they are, and the
+  /// stored blocks are padded to a multiple of 4 bytes, such that they end
+  /// exactly with the record and readers can locate them without copying them
+  /// out of the SIOCompressedBlocksBlock.
+  ///
+  /// The blocks are serialized and compressed on the threads of the passed
+  /// pool (if any), otherwise on the calling thread only
+  inline SIOEncodedRecord encodeCompressedBlocks(const sio::block_list& blocks, const std::string& recordName,
+                                                 SIOCompressedBlockIndexBlock& index,
+                                                 std::size_t initBufferSize = sio::mbyte,
+                                                 int compressionLevel = defaultCompressionLevel,
+                                                 utils::ThreadPool* pool = nullptr) {
+    const bool compress = compressionLevel > 0;
+    std::vector<sio::buffer::container> encoded(blocks.size());
+    std::vector<uint32_t> uncompressedSizes(blocks.size());
+
+    const auto compressBlock = [&](size_t i) {
+      // Every thread reuses its buffers for all the blocks it handles. Since
+      // the threads of the pool live as long as the writer, this also holds
+      // across Frames
+      thread_local sio::buffer blockBuffer{initBufferSize};
+      thread_local sio::buffer compBuffer{initBufferSize};
+      sio::zlib_compression compressor;
+      compressor.set_level(compressionLevel);
+
+      // Use an in memory record to get the serialized block (including its
+      // header) without having to deal with the details of the SIO layout.
+      // Only its data is compressed, which is exactly the block
+      auto blockInfo = sio::api::write_record(recordName, blockBuffer, {blocks[i]}, 0);
+      if (compress) {
+        sio::api::compress_record(blockInfo, blockBuffer, compBuffer, compressor);
+        encoded[i].assign(compBuffer.data(), compBuffer.data() + compBuffer.size());
+      } else {
+        const auto* blockData = blockBuffer.data() + blockInfo._header_length;
+        encoded[i].assign(blockData, blockData + blockInfo._data_length);
+      }
+      uncompressedSizes[i] = blockInfo._uncompressed_length;
+    };
 
-      sio::api::write_record(stream, buffer.span(0, recInfo._header_length), comBuffer.span(), recInfo);
+    if (pool) {
+      pool->parallelFor(blocks.size(), compressBlock);
     } else {
-      sio::api::write_record(stream, buffer.span(), recInfo);
+      for (size_t i = 0; i < blocks.size(); ++i) {
+        compressBlock(i);
+      }
     }
 
-    return recInfo._file_start;
+    auto compressedBlocks = std::make_shared<SIOCompressedBlocksBlock>();
+    auto& data = compressedBlocks->data;
+    for (size_t i = 0; i < blocks.size(); ++i) {
+      index.addBlock(data.size(), encoded[i].size(), uncompressedSizes[i]);
+      data.insert(data.end(), encoded[i].begin(), encoded[i].end());
+    }
+    index.compressed = compress;
+    if (!compress) {
+      data.resize(storedBlocksSize(index.offsets, index.compressedSizes), 0);
+    }
+
+    return encodeRecord({compressedBlocks}, recordName, initBufferSize, false);
+  }
+
+  /// Write a record that has previously been encoded and return where it
+  /// starts in the file
+  inline sio::ifstream::pos_type writeEncodedRecord(SIOEncodedRecord& record, sio::ofstream& stream) {
+    if (record.compressed) {
+      sio::api::write_record(stream, record.buffer.span(0, record.info._header_length), record.compressed->span(),
+                             record.info);
+    } else {
+      sio::api::write_record(stream, record.buffer.span(), record.info);
+    }
+
+    return record.info._file_start;
+  }
+
+  /// Write the passed record and return where it starts in the file
+  inline sio::ifstream::pos_type writeRecord(const sio::block_list& blocks, const std::string& recordName,
+                                             sio::ofstream& stream, std::size_t initBufferSize = sio::mbyte,
+                                             bool compress = true, int compressionLevel = defaultCompressionLevel) {
+    auto record = encodeRecord(blocks, recordName, initBufferSize, compress, compressionLevel);
+    return writeEncodedRecord(record, stream);
   }
 
 } // namespace sio_utils
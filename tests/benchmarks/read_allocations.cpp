@@ -0,0 +1,224 @@
+#include "datamodel/DatamodelDefinition.h"
+#include "datamodel/ExampleClusterCollection.h"
+#include "datamodel/ExampleHitCollection.h"
+#include "datamodel/ExampleWithVectorMemberCollection.h"
+
+#include "podio/CollectionBufferFactory.h"
+#include "podio/CollectionIDTable.h"
+#include "podio/Frame.h"
+#include "podio/GenericParameters.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Benchmark counting the heap allocations that are necessary to get the
+// collections from a Frame that has been "read" and to access all their
+// elements once. The data is created in memory to not depend on any I/O backend
+//
+// Average allocations per event with the defaults (10 events, 10000 elements),
+// before and after the Objs of read collections are created lazily in a single
+// block (the hits are unpacked while getting the clusters):
+//
+//   collection      before (get / size / access)   after (get / size / access)
+//   clusters        361 / 0 / 0                     18 / 0 / 6
+//   hits              0 / 0 / 0                      0 / 0 / 0
+//   vectorMembers 10169 / 0 / 0                      5 / 0 / 3
+
+namespace {
+std::atomic<size_t> allocations{0};
+}
+
+// GCC cannot see that the replacement operator new uses malloc
+#if defined(__GNUC__) && !defined(__clang__)
+  #pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size) {
+  ++allocations;
+  if (auto ptr = std::malloc(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+/// Minimal FrameData that hands out the buffers that have been filled in memory
+class InMemoryFrameData {
+public:
+  using BufferMap = std::unordered_map<std::string, podio::CollectionReadBuffers>;
+
+  InMemoryFrameData(BufferMap&& buffers, podio::CollectionIDTable&& idTable) :
+      m_buffers(std::move(buffers)), m_idTable(std::move(idTable)) {
+  }
+
+  InMemoryFrameData(InMemoryFrameData&&) = default;
+  InMemoryFrameData& operator=(InMemoryFrameData&&) = default;
+  InMemoryFrameData(const InMemoryFrameData&) = delete;
+  InMemoryFrameData& operator=(const InMemoryFrameData&) = delete;
+
+  ~InMemoryFrameData() {
+    for (auto& [_, buffer] : m_buffers) {
+      buffer.deleteBuffers(buffer);
+    }
+  }
+
+  std::optional<podio::CollectionReadBuffers> getCollectionBuffers(const std::string& name) {
+    const auto bufferHandle = m_buffers.extract(name);
+    if (bufferHandle.empty()) {
+      return std::nullopt;
+    }
+    return {bufferHandle.mapped()};
+  }
+
+  podio::CollectionIDTable getIDTable() const {
+    return {m_idTable.ids(), m_idTable.names()};
+  }
+
+  std::unique_ptr<podio::GenericParameters> getParameters() {
+    return std::make_unique<podio::GenericParameters>();
+  }
+
+  std::vector<std::string> getAvailableCollections() const {
+    std::vector<std::string> collections;
+    for (const auto& [name, _] : m_buffers) {
+      collections.push_back(name);
+    }
+    return collections;
+  }
+
+private:
+  BufferMap m_buffers{};
+  podio::CollectionIDTable m_idTable{};
+};
+
+podio::CollectionReadBuffers createBuffers(const std::string& type) {
+  return podio::CollectionBufferFactory::instance().createBuffers(type, datamodel::meta::schemaVersion, false).value();
+}
+
+/// Fill the buffers for one event in the same way as a reader would
+InMemoryFrameData createFrameData(size_t nElements) {
+  InMemoryFrameData::BufferMap buffers;
+  podio::CollectionIDTable idTable;
+  const auto hitsID = idTable.add("hits");
+  idTable.add("clusters");
+  idTable.add("vectorMembers");
+
+  auto hitBuffers = createBuffers("ExampleHitCollection");
+  auto hitData = hitBuffers.dataAsVector<ExampleHitData>();
+  for (size_t i = 0; i < nElements; ++i) {
+    hitData->push_back({i, 1.0 * i, 2.0 * i, 3.0 * i, 0.5 * i});
+  }
+  buffers.emplace("hits", hitBuffers);
+
+  // Every cluster points to one hit
+  auto clusterBuffers = createBuffers("ExampleClusterCollection");
+  auto clusterData = clusterBuffers.dataAsVector<ExampleClusterData>();
+  auto& hitRefs = (*clusterBuffers.references)[0];
+  for (size_t i = 0; i < nElements; ++i) {
+    const auto index = static_cast<unsigned>(i);
+    clusterData->push_back({0.5 * i, index, index + 1, 0, 0});
+    hitRefs->emplace_back(static_cast<int>(i), hitsID);
+  }
+  buffers.emplace("clusters", clusterBuffers);
+
+  auto vecMemBuffers = createBuffers("ExampleWithVectorMemberCollection");
+  auto vecMemData = vecMemBuffers.dataAsVector<ExampleWithVectorMemberData>();
+  auto counts = podio::CollectionReadBuffers::asVector<int>((*vecMemBuffers.vectorMembers)[0].second);
+  for (size_t i = 0; i < nElements; ++i) {
+    const auto index = static_cast<unsigned>(i);
+    vecMemData->push_back({2 * index, 2 * index + 2});
+    counts->push_back(static_cast<int>(i));
+    counts->push_back(static_cast<int>(i) + 1);
+  }
+  buffers.emplace("vectorMembers", vecMemBuffers);
+
+  return {std::move(buffers), std::move(idTable)};
+}
+
+struct AllocationCounts {
+  size_t get{0};    ///< Allocations for getting the collection from the Frame
+  size_t size{0};   ///< Allocations for querying the size of the collection
+  size_t access{0}; ///< Allocations for accessing all elements once
+};
+
+template <typename CollT, typename AccessF>
+void countAllocations(const podio::Frame& frame, const std::string& name, AccessF&& accessFunc,
+                      AllocationCounts& counts) {
+  auto start = allocations.load();
+  const auto& coll = frame.get<CollT>(name);
+  counts.get += allocations.load() - start;
+
+  start = allocations.load();
+  if (coll.empty() || coll.size() == 0) {
+    std::cerr << "This should never happen" << std::endl;
+  }
+  counts.size += allocations.load() - start;
+
+  start = allocations.load();
+  double sum = 0;
+  for (const auto elem : coll) {
+    sum += accessFunc(elem);
+  }
+  counts.access += allocations.load() - start;
+  if (sum < 0) {
+    std::cerr << "This should never happen" << std::endl;
+  }
+}
+
+int main(int argc, char* argv[]) {
+  const size_t nEvents = argc > 1 ? std::stoul(argv[1]) : 10;
+  const size_t nElements = argc > 2 ? std::stoul(argv[2]) : 10000;
+
+  AllocationCounts hitCounts, clusterCounts, vecMemCounts;
+  for (size_t i = 0; i < nEvents; ++i) {
+    const auto frame = podio::Frame(createFrameData(nElements));
+    // The clusters are unpacked first, such that the hits are only unpacked
+    // for resolving the relations
+    countAllocations<ExampleClusterCollection>(
+        frame, "clusters", [](const auto& cluster) { return cluster.Hits(0).energy(); }, clusterCounts);
+    countAllocations<ExampleHitCollection>(
+        frame, "hits", [](const auto& hit) { return hit.energy(); }, hitCounts);
+    countAllocations<ExampleWithVectorMemberCollection>(
+        frame, "vectorMembers", [](const auto& elem) { return elem.count(1); }, vecMemCounts);
+  }
+
+  std::cout << "Average number of allocations per event for " << nElements << " elements per collection\n"
+            << std::setw(16) << "collection" << std::setw(12) << "get" << std::setw(12) << "size" << std::setw(12)
+            << "access" << '\n';
+  bool perElementAllocs = false;
+  bool sizeAllocs = false;
+  for (const auto& [name, counts] : {std::pair{"clusters", clusterCounts}, std::pair{"hits", hitCounts},
+                                     std::pair{"vectorMembers", vecMemCounts}}) {
+    const auto total = (counts.get + counts.size + counts.access) / nEvents;
+    std::cout << std::setw(16) << name << std::setw(12) << counts.get / nEvents << std::setw(12)
+              << counts.size / nEvents << std::setw(12) << counts.access / nEvents << '\n';
+    perElementAllocs = perElementAllocs || total >= nElements;
+    sizeAllocs = sizeAllocs || counts.size > 0;
+  }
+
+  if (sizeAllocs) {
+    std::cerr << "Querying the size of a collection should not need any allocations" << std::endl;
+    return 1;
+  }
+
+  if (perElementAllocs) {
+    std::cerr << "Reading needs at least one allocation per element" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
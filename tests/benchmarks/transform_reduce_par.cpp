@@ -0,0 +1,71 @@
+#include "datamodel/ExampleHitCollection.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <execution>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+#include <string>
+
+// Benchmark comparing std::transform_reduce over the elements of a collection
+// with the sequential and the parallel execution policy. The parallel
+// algorithms dispatch on the iterator_category, which is only that of an input
+// iterator, since dereferencing yields a handle by value. Hence, this mainly
+// shows the overhead of the parallel policy for collection iterators
+
+static_assert(std::random_access_iterator<ExampleHitCollection::const_iterator>);
+
+namespace {
+template <typename Policy>
+double sumEnergies(Policy&& policy, const ExampleHitCollection& hits) {
+  return std::transform_reduce(policy, hits.begin(), hits.end(), 0.0, std::plus<>{},
+                               [](const auto& hit) { return hit.energy(); });
+}
+
+template <typename Policy>
+double timeSum(Policy&& policy, const ExampleHitCollection& hits, size_t nRepetitions, double& sum) {
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < nRepetitions; ++i) {
+    sum = sumEnergies(policy, hits);
+  }
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count() / nRepetitions;
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+  const size_t nElements = argc > 1 ? std::stoul(argv[1]) : 1'000'000;
+  const size_t nRepetitions = argc > 2 ? std::stoul(argv[2]) : 5;
+
+  auto hits = ExampleHitCollection();
+  double expected = 0;
+  for (size_t i = 0; i < nElements; ++i) {
+    const auto energy = static_cast<double>(i % 1000) * 0.5;
+    hits.create(static_cast<uint64_t>(i), 0.0, 0.0, 0.0, energy);
+    expected += energy;
+  }
+
+  double seqSum = 0;
+  double parSum = 0;
+  const auto seqTime = timeSum(std::execution::seq, hits, nRepetitions, seqSum);
+  const auto parTime = timeSum(std::execution::par, hits, nRepetitions, parSum);
+
+  std::cout << "std::transform_reduce over " << nElements << " elements (average of " << nRepetitions << " runs)\n"
+            << std::setw(8) << "policy" << std::setw(12) << "time [ms]" << '\n'
+            << std::setw(8) << "seq" << std::setw(12) << seqTime << '\n'
+            << std::setw(8) << "par" << std::setw(12) << parTime << '\n';
+
+  // The summands are multiples of 0.5 and small enough to be summed exactly,
+  // regardless of the order
+  if (seqSum != expected || parSum != expected) {
+    std::cerr << "Sums do not match: expected " << expected << ", seq: " << seqSum << ", par: " << parSum
+              << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
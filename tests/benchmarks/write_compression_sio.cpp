@@ -0,0 +1,90 @@
+#include "datamodel/ExampleHitCollection.h"
+
+#include "podio/Frame.h"
+#include "podio/SIOReader.h"
+#include "podio/SIOWriter.h"
+#include "podio/WriterOptions.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Benchmark measuring the throughput of the SIOWriter for large Frames with
+// many collections, depending on the number of threads that are used for
+// compressing them. The written files are read back to make sure that they
+// are still readable
+
+namespace {
+podio::Frame makeFrame(size_t iEvent, size_t nCollections, size_t nElements) {
+  auto frame = podio::Frame();
+  for (size_t c = 0; c < nCollections; ++c) {
+    auto hits = ExampleHitCollection();
+    for (size_t i = 0; i < nElements; ++i) {
+      // Values that are not trivially compressible, but also not random
+      const auto val = static_cast<double>((i * 7919 + c * 104729 + iEvent) % 10007);
+      hits.create(static_cast<uint64_t>(i), val * 0.1, val * 0.2, val * 0.3, val * 1e-3);
+    }
+    frame.put(std::move(hits), "hits_" + std::to_string(c));
+  }
+  return frame;
+}
+
+/// Check that all frames can be read again and contain the expected data
+bool checkFile(const std::string& filename, size_t nEvents, size_t nCollections, size_t nElements) {
+  auto reader = podio::SIOReader();
+  reader.openFile(filename);
+  if (reader.getEntries(podio::Category::Event) != nEvents) {
+    std::cerr << filename << ": Expected " << nEvents << " events" << std::endl;
+    return false;
+  }
+  for (size_t i = 0; i < nEvents; ++i) {
+    const auto frame = podio::Frame(reader.readNextEntry(podio::Category::Event));
+    const auto& hits = frame.get<ExampleHitCollection>("hits_" + std::to_string(nCollections - 1));
+    if (hits.size() != nElements || hits[nElements - 1].cellID() != nElements - 1) {
+      std::cerr << filename << ": Unexpected contents of event " << i << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+  const size_t nEvents = argc > 1 ? std::stoul(argv[1]) : 5;
+  const size_t nCollections = argc > 2 ? std::stoul(argv[2]) : 20;
+  const size_t nElements = argc > 3 ? std::stoul(argv[3]) : 5000;
+
+  std::vector<podio::Frame> frames;
+  frames.reserve(nEvents);
+  for (size_t i = 0; i < nEvents; ++i) {
+    frames.emplace_back(makeFrame(i, nCollections, nElements));
+  }
+  const double dataMB = 1e-6 * nEvents * nCollections * nElements * sizeof(ExampleHitData);
+
+  std::cout << "Writing " << nEvents << " events with " << nCollections << " collections of " << nElements
+            << " elements (" << dataMB << " MB)\n"
+            << std::setw(10) << "threads" << std::setw(12) << "time [ms]" << std::setw(12) << "MB/s" << '\n';
+
+  bool success = true;
+  for (const unsigned nThreads : {1u, 4u, 16u}) {
+    const auto filename = "write_compression_sio_" + std::to_string(nThreads) + ".sio";
+    const auto start = std::chrono::steady_clock::now();
+    {
+      auto writer = podio::SIOWriter(filename, podio::WriterOptions{}.setCompressionThreads(nThreads));
+      for (const auto& frame : frames) {
+        writer.writeFrame(frame, podio::Category::Event);
+      }
+      writer.finish();
+    }
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << std::setw(10) << nThreads << std::setw(12) << std::fixed << std::setprecision(1) << elapsed
+              << std::setw(12) << dataMB / (elapsed * 1e-3) << '\n';
+
+    success = checkFile(filename, nEvents, nCollections, nElements) && success;
+  }
+
+  return success ? 0 : 1;
+}
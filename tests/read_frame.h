@@ -209,6 +209,13 @@ int read_frames(const std::string& filename, bool assertBuildVersion = true) {
       }
     }
 
+    const auto hitsSize = frame.getCollectionSize("hits");
+    if (!hitsSize || hitsSize->valueType != "ExampleHit" ||
+        hitsSize->elements != frame.get<ExampleHitCollection>("hits").size()) {
+      std::cerr << "Collection size information for 'hits' not as expected" << std::endl;
+      return 1;
+    }
+
     processEvent(frame, i, reader.currentFileVersion());
 
     auto otherFrame = podio::Frame(reader.readNextEntry("other_events"));
@@ -262,6 +269,14 @@ int read_frames(const std::string& filename, bool assertBuildVersion = true) {
       processExtensions(previousFrame, 2 + 100, reader.currentFileVersion());
     }
 
+    // Unpacking everything up front yields the same contents
+    auto prefetchedFrame = podio::Frame(reader.readEntry("other_events", 3));
+    prefetchedFrame.prefetchAll();
+    processEvent(prefetchedFrame, 3 + 100, reader.currentFileVersion());
+    if (reader.currentFileVersion() > podio::version::Version{0, 16, 2}) {
+      processExtensions(prefetchedFrame, 3 + 100, reader.currentFileVersion());
+    }
+
     // Trying to read a Frame that is not present returns a nullptr
     if (reader.readEntry(podio::Category::Event, 10)) {
       std::cerr << "Trying to read a specific entry that does not exist should return a nullptr" << std::endl;
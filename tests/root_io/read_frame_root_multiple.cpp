@@ -73,6 +73,28 @@ int read_frames(podio::ROOTReader& reader) {
     processExtensions(previousFrame, 2 + 100, reader.currentFileVersion());
   }
 
+  // Reading several entries in one go, across a file boundary
+  {
+    auto entries = reader.readEntries("events", 8, 4);
+    if (entries.size() != 4) {
+      std::cerr << "Could not read the requested number of entries in one go (expected: 4, actual: "
+                << entries.size() << ")" << std::endl;
+      return 1;
+    }
+    for (size_t i = 0; i < entries.size(); ++i) {
+      auto frame = podio::Frame(std::move(entries[i]));
+      processEvent(frame, (8 + i) % 10, reader.currentFileVersion());
+    }
+    // Reading the next entry continues after the ones that have been read
+    auto nextFrame = podio::Frame(reader.readNextEntry("events"));
+    processEvent(nextFrame, 2, reader.currentFileVersion());
+
+    if (reader.readEntries("events", 18, 5).size() != 2) {
+      std::cerr << "Reading more entries than available should return only the available ones" << std::endl;
+      return 1;
+    }
+  }
+
   // Trying to read a Frame that is not present returns a nullptr
   if (reader.readEntry("events", 30)) {
     std::cerr << "Trying to read a specific entry that does not exist should return a nullptr" << std::endl;
@@ -82,8 +104,26 @@ int read_frames(podio::ROOTReader& reader) {
   return 0;
 }
 
+int read_frames_prefetched() {
+  auto reader = podio::ROOTReader();
+  reader.enablePrefetch(3);
+  reader.openFiles({"example_frame.root", "example_frame.root"});
+  if (read_frames(reader)) {
+    return 1;
+  }
+
+  const auto stats = reader.getPrefetchStatistics();
+  if (stats.nPrefetched == 0 || stats.maxQueueDepth > 3) {
+    std::cerr << "Prefetching statistics not as expected (prefetched: " << stats.nPrefetched
+              << ", max queue depth: " << stats.maxQueueDepth << ")" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
+
 int main() {
   auto reader = podio::ROOTReader();
   reader.openFiles({"example_frame.root", "example_frame.root"});
-  return read_frames(reader);
+  return read_frames(reader) + read_frames_prefetched();
 }
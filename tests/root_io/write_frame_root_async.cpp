@@ -0,0 +1,40 @@
+#include "write_frame.h"
+
+#include "podio/AsyncWriter.h"
+#include "podio/ROOTReader.h"
+#include "podio/ROOTWriter.h"
+
+#include <iostream>
+#include <memory>
+
+/// Write the same Frames as write_frame_root via an AsyncWriter, while reading
+/// another file on the main thread, i.e. while the I/O thread is writing
+int main(int, char**) {
+  auto reader = podio::ROOTReader();
+  reader.openFile("example_frame.root");
+
+  podio::AsyncWriter writer(podio::Writer{std::make_unique<podio::ROOTWriter>("example_frame_async.root")}, 2);
+
+  for (int i = 0; i < 10; ++i) {
+    writer.writeFrame(makeFrame(i), podio::Category::Event, collsToWrite);
+
+    const auto frame = podio::Frame(reader.readNextEntry(podio::Category::Event));
+    const auto anInt = frame.getParameter<int>("anInt").value_or(-1);
+    if (anInt != 42 + i) {
+      std::cerr << "Could not read back the expected parameter value while writing asynchronously (expected: "
+                << 42 + i << ", actual: " << anInt << ")" << std::endl;
+      return 1;
+    }
+    if (frame.get<ExampleHitCollection>("hits").size() != 2) {
+      std::cerr << "Could not read back the hits while writing asynchronously" << std::endl;
+      return 1;
+    }
+  }
+
+  for (int i = 100; i < 110; ++i) {
+    writer.writeFrame(makeFrame(i), "other_events");
+  }
+
+  writer.finish();
+  return 0;
+}
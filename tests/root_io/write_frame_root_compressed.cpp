@@ -0,0 +1,11 @@
+#include "write_frame.h"
+
+#include "podio/ROOTWriter.h"
+
+int main(int, char**) {
+  auto options = podio::WriterOptions{}.setCompression(podio::CompressionCodec::LZ4);
+  options.setCompression("other_events", podio::CompressionCodec::ZSTD, 9);
+
+  write_frames<podio::ROOTWriter>("example_frame_compressed.root", options);
+  return 0;
+}
@@ -0,0 +1,8 @@
+#include "write_frame.h"
+
+#include "podio/ROOTWriter.h"
+
+int main(int, char**) {
+  write_frames_concurrent<podio::ROOTWriter>("example_frame_concurrent.root");
+  return 0;
+}
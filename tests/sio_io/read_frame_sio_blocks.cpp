@@ -0,0 +1,160 @@
+#include "read_test.h"
+#include "write_frame.h"
+
+#include "podio/Frame.h"
+#include "podio/FrameCategories.h"
+#include "podio/SIOBlock.h"
+#include "podio/SIOFrameData.h"
+#include "podio/SIOWriter.h"
+#include "podio/WriterOptions.h"
+
+#include "sioUtils.h"
+
+#include <sio/api.h>
+#include <sio/compression/zlib.h>
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+/// The table and data records of one Frame, as they would be written to file
+struct FrameRecords {
+  podio::SIOEncodedRecord table;
+  podio::SIOEncodedRecord data;
+};
+
+/// Get the data of a record without its header, as it is stored in a file
+sio::buffer_span recordData(podio::SIOEncodedRecord& record) {
+  if (record.compressed) {
+    return record.compressed->span();
+  }
+  return record.buffer.span(record.info._header_length, record.info._data_length);
+}
+
+/// Create the Frame data from records that are kept in memory
+std::unique_ptr<podio::SIOFrameData> makeFrameData(std::shared_ptr<FrameRecords> records) {
+  const auto data = recordData(records->data);
+  const auto table = recordData(records->table);
+  return std::make_unique<podio::SIOFrameData>(data, records->data.info, table, records->table.info,
+                                               std::move(records));
+}
+
+/// Check that reading a collection only decompresses its own block, by
+/// corrupting the block of another collection that is not read
+int test_decompress_requested_blocks() {
+  const auto frame = makeFrame(0);
+  auto writer = podio::SIOWriter("example_frame_blocks.sio");
+  auto encoded = writer.encodeFrame(frame, podio::Category::Event, {"hits", "clusters"});
+
+  sio::buffer uncTable{encoded.table.info._uncompressed_length};
+  sio::zlib_compression compressor;
+  compressor.uncompress(recordData(encoded.table), uncTable);
+  auto blockIndex = std::make_shared<podio::SIOCompressedBlockIndexBlock>();
+  sio::api::read_blocks(uncTable.span(), {blockIndex});
+  // parameters, hits, clusters
+  if (blockIndex->offsets.size() != 3) {
+    std::cerr << "The blocks of the Frame have not been compressed separately" << std::endl;
+    return 1;
+  }
+
+  // Break the zlib header of the clusters block
+  auto compressedBlocks = std::make_shared<podio::SIOCompressedBlocksBlock>();
+  sio::api::read_blocks(recordData(encoded.data), {compressedBlocks});
+  compressedBlocks->data[blockIndex->offsets[2]] = 0;
+
+  auto records = std::make_shared<FrameRecords>(FrameRecords{
+      std::move(encoded.table),
+      podio::sio_utils::encodeRecord({compressedBlocks}, podio::Category::Event, sio::mbyte, false)});
+  const auto event = podio::Frame(makeFrameData(std::move(records)));
+
+  const auto& hits = event.get<ExampleHitCollection>("hits");
+  if (hits.size() != 2 || event.getParameter<int>("anInt").value_or(0) != 42) {
+    std::cerr << "Could not read the hits and the parameters next to a corrupted block" << std::endl;
+    return 1;
+  }
+
+  try {
+    event.get<ExampleClusterCollection>("clusters");
+  } catch (const std::exception&) {
+    return 0;
+  }
+  std::cerr << "Reading the collection with the corrupted block did not fail" << std::endl;
+  return 1;
+}
+
+/// Check that a compression level of 0 stores the blocks without compression
+/// (which is marked in the index) and that they are read directly from the
+/// record, without touching the blocks that are not requested
+int test_level_zero_layout() {
+  const auto frame = makeFrame(0);
+  auto writer = podio::SIOWriter("example_frame_blocks_level0.sio",
+                                 podio::WriterOptions{}.setCompression(podio::CompressionCodec::None));
+  auto encoded = writer.encodeFrame(frame, podio::Category::Event, {"hits", "clusters"});
+
+  sio::buffer uncTable{encoded.table.info._uncompressed_length};
+  sio::zlib_compression compressor;
+  compressor.uncompress(recordData(encoded.table), uncTable);
+  auto blockIndex = std::make_shared<podio::SIOCompressedBlockIndexBlock>();
+  sio::api::read_blocks(uncTable.span(), {blockIndex});
+  if (blockIndex->compressed || blockIndex->offsets.size() != 3 ||
+      blockIndex->compressedSizes != blockIndex->uncompressedSizes) {
+    std::cerr << "The blocks have not been stored without compression for a compression level of 0" << std::endl;
+    return 1;
+  }
+
+  // Break the header of the stored clusters block in place. The stored blocks
+  // are at the end of the record
+  const auto storedSize = podio::sio_utils::storedBlocksSize(blockIndex->offsets, blockIndex->compressedSizes);
+  const auto clustersPos = encoded.data.info._header_length + encoded.data.info._data_length - storedSize +
+      blockIndex->offsets[2];
+  std::fill_n(encoded.data.buffer.data() + clustersPos, 8, static_cast<sio::byte>(0xff));
+
+  auto records = std::make_shared<FrameRecords>(FrameRecords{std::move(encoded.table), std::move(encoded.data)});
+  const auto event = podio::Frame(makeFrameData(std::move(records)));
+  const auto& hits = event.get<ExampleHitCollection>("hits");
+  if (hits.size() != 2 || hits[0].energy() != 23 || event.getParameter<int>("anInt").value_or(0) != 42) {
+    std::cerr << "Could not read back the collections written with a compression level of 0" << std::endl;
+    return 1;
+  }
+
+  try {
+    event.get<ExampleClusterCollection>("clusters");
+  } catch (const std::exception&) {
+    return 0;
+  }
+  std::cerr << "Reading the collection with the corrupted stored block did not fail" << std::endl;
+  return 1;
+}
+
+/// Check that Frames in which the data record is compressed as a whole (i.e.
+/// the layout before the blocks were compressed separately) can still be read
+int test_read_whole_record_compression() {
+  auto& libLoader [[maybe_unused]] = podio::SIOBlockLibraryLoader::instance();
+
+  const auto frame = makeFrame(0);
+  std::vector<podio::sio_utils::StoreCollection> collections;
+  for (const auto& name : collsToWrite) {
+    collections.emplace_back(name, frame.getCollectionForWrite(name));
+  }
+
+  // This is how the SIOWriter encoded Frames before
+  auto table = podio::sio_utils::encodeRecord(
+      {podio::sio_utils::createCollIDBlock(collections, frame.getCollectionIDTableForWrite())},
+      std::string(podio::Category::Event) + "_HEADER");
+  auto data = podio::sio_utils::encodeRecord(podio::sio_utils::createBlocks(collections, frame.getParameters()),
+                                             podio::Category::Event);
+
+  const auto event =
+      podio::Frame(makeFrameData(std::make_shared<FrameRecords>(FrameRecords{std::move(table), std::move(data)})));
+  processEvent(event, 0, podio::version::build_version);
+  return 0;
+}
+} // namespace
+
+int main(int, char**) {
+  return test_decompress_requested_blocks() + test_level_zero_layout() + test_read_whole_record_compression();
+}
@@ -0,0 +1,48 @@
+#include "read_frame.h"
+#include "read_frame_auxiliary.h"
+
+#include "podio/SIOReader.h"
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+/// An SIOReader that reads everything via a memory mapping of the files
+struct MappedSIOReader : podio::SIOReader {
+  MappedSIOReader() {
+    enableMemoryMap();
+  }
+};
+
+/// Check that the Frame data remain valid after the reader (and with it the
+/// memory mapping it has created) is gone
+int test_outlive_reader(const std::string& inputFile) {
+  std::unique_ptr<podio::SIOFrameData> frameData{nullptr};
+  {
+    auto reader = MappedSIOReader();
+    reader.openFile(inputFile);
+    frameData = reader.readEntry(podio::Category::Event, 1);
+  }
+
+  const auto event = podio::Frame(std::move(frameData));
+  const auto& hits = event.get<ExampleHitCollection>("hits");
+  if (hits.size() != 2 || hits[0].energy() != 24) {
+    std::cerr << "Could not read the expected hits after the reader has been destroyed" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  std::string inputFile = "example_frame.sio";
+  bool assertBuildVersion = true;
+  if (argc == 2) {
+    inputFile = argv[1];
+    assertBuildVersion = false;
+  }
+
+  return read_frames<MappedSIOReader>(inputFile, assertBuildVersion) +
+      test_frame_aux_info<MappedSIOReader>(inputFile) + test_read_frame_limited<MappedSIOReader>(inputFile) +
+      test_outlive_reader(inputFile);
+}
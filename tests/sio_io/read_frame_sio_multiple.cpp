@@ -0,0 +1,92 @@
+#include "read_frame.h"
+
+#include "podio/SIOReader.h"
+
+int read_frames(podio::SIOReader& reader) {
+  if (reader.currentFileVersion() != podio::version::build_version) {
+    std::cerr << "The podio build version could not be read back correctly. "
+              << "(expected:" << podio::version::build_version << ", actual: " << reader.currentFileVersion() << ")"
+              << std::endl;
+    return 1;
+  }
+
+  if (reader.getEntries("events") != 20) {
+    std::cerr << "Could not read back the number of events correctly. "
+              << "(expected:" << 20 << ", actual: " << reader.getEntries("events") << ")" << std::endl;
+    return 1;
+  }
+
+  if (reader.getEntries("events") != reader.getEntries("other_events")) {
+    std::cerr << "Could not read back the number of events correctly. "
+              << "(expected:" << 20 << ", actual: " << reader.getEntries("other_events") << ")" << std::endl;
+    return 1;
+  }
+
+  for (size_t i = 0; i < reader.getEntries("events"); ++i) {
+    auto frame = podio::Frame(reader.readNextEntry("events"));
+    processEvent(frame, (i % 10), reader.currentFileVersion());
+
+    auto otherFrame = podio::Frame(reader.readNextEntry("other_events"));
+    processEvent(otherFrame, (i % 10) + 100, reader.currentFileVersion());
+    // The other_events category also holds external collections
+    processExtensions(otherFrame, (i % 10) + 100, reader.currentFileVersion());
+  }
+
+  if (reader.readNextEntry("events")) {
+    std::cerr << "Trying to read more frame data than is present should return a nullptr" << std::endl;
+    return 1;
+  }
+
+  // Jump over a file boundary and back again
+  {
+    auto otherFrame = podio::Frame(reader.readEntry("other_events", 14));
+    processEvent(otherFrame, 4 + 100, reader.currentFileVersion());
+    processExtensions(otherFrame, 4 + 100, reader.currentFileVersion());
+
+    auto previousFrame = podio::Frame(reader.readEntry("other_events", 2));
+    processEvent(previousFrame, 2 + 100, reader.currentFileVersion());
+    processExtensions(previousFrame, 2 + 100, reader.currentFileVersion());
+  }
+
+  // Reading several entries concurrently, across a file boundary
+  {
+    auto entries = reader.readEntries("events", 6, 8, {}, 3);
+    if (entries.size() != 8) {
+      std::cerr << "Could not read the requested number of entries in one go (expected: 8, actual: "
+                << entries.size() << ")" << std::endl;
+      return 1;
+    }
+    for (size_t i = 0; i < entries.size(); ++i) {
+      auto frame = podio::Frame(std::move(entries[i]));
+      processEvent(frame, (6 + i) % 10, reader.currentFileVersion());
+    }
+    // Reading the next entry continues after the ones that have been read
+    auto nextFrame = podio::Frame(reader.readNextEntry("events"));
+    processEvent(nextFrame, 4, reader.currentFileVersion());
+
+    // The streams of the threads are reused by later calls
+    entries = reader.readEntries("events", 2, 6, {}, 3);
+    for (size_t i = 0; i < entries.size(); ++i) {
+      auto frame = podio::Frame(std::move(entries[i]));
+      processEvent(frame, 2 + i, reader.currentFileVersion());
+    }
+
+    if (reader.readEntries("events", 18, 5).size() != 2) {
+      std::cerr << "Reading more entries than available should return only the available ones" << std::endl;
+      return 1;
+    }
+  }
+
+  if (reader.readEntry("events", 30)) {
+    std::cerr << "Trying to read a specific entry that does not exist should return a nullptr" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
+
+int main() {
+  auto reader = podio::SIOReader();
+  reader.openFiles({"example_frame.sio", "example_frame.sio"});
+  return read_frames(reader);
+}
@@ -0,0 +1,79 @@
+#include "read_frame.h"
+
+#include "podio/SIOBlock.h"
+#include "podio/SIOReader.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+// Size of the hole that is put into the middle of the file, to push the
+// second half of the records and the TOC beyond 4 GiB
+constexpr uint64_t holeSize = 5ull << 30;
+
+/// Create a (sparse) copy of the input file, with a hole in front of the
+/// entry splitEntry of the events category and a 64 bit TOC at the end.
+void createLargeFile(const std::string& inputFile, const std::string& outputFile, unsigned splitEntry) {
+  sio::ifstream input(inputFile, std::ios::binary);
+  podio::SIOFileTOCRecord toc{};
+  if (!podio::sio_helpers::readFileTOCRecord(input, toc)) {
+    throw std::runtime_error("Could not read the TOC record from " + inputFile);
+  }
+  const auto splitPos = toc.getPosition("events", splitEntry);
+
+  // Shift all records after the split position by the hole
+  podio::SIOFileTOCRecord largeToc{};
+  for (const auto& name : toc.getRecordNames()) {
+    const auto recordName = std::string(name);
+    for (size_t i = 0; i < toc.getNRecords(recordName); ++i) {
+      const auto pos = toc.getPosition(recordName, i);
+      largeToc.addRecord(recordName, pos < splitPos ? pos : pos + holeSize);
+    }
+  }
+
+  const auto content = std::vector<char>(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+
+  // Copying everything after the split (including the old TOC) is fine, since
+  // readers only find the TOC via the final marker
+  sio::ofstream output(outputFile, std::ios::binary);
+  output.write(content.data(), splitPos);
+  output.seekp(splitPos + holeSize);
+  output.write(content.data() + splitPos, content.size() - splitPos);
+  podio::sio_helpers::writeFileTOCRecord(output, largeToc);
+}
+
+int main() {
+  const auto largeFile = std::string("example_frame_large.sio");
+  createLargeFile("example_frame.sio", largeFile, 5);
+
+  if (std::filesystem::file_size(largeFile) <= holeSize) {
+    std::cerr << "The created file is not larger than 4 GiB" << std::endl;
+    return 1;
+  }
+
+  auto reader = podio::SIOReader();
+  reader.openFile(largeFile);
+
+  int result = 0;
+  if (reader.getEntries("events") != 10 || reader.getEntries("other_events") != 10) {
+    std::cerr << "Could not read back the number of events correctly from a file larger than 4 GiB" << std::endl;
+    result = 1;
+  } else {
+    // Jump around randomly on both sides of the hole
+    for (const auto i : {7u, 2u, 9u, 0u, 5u, 4u}) {
+      auto frame = podio::Frame(reader.readEntry("events", i));
+      processEvent(frame, i, reader.currentFileVersion());
+
+      auto otherFrame = podio::Frame(reader.readEntry("other_events", i));
+      processEvent(otherFrame, i + 100, reader.currentFileVersion());
+    }
+
+    // The next entry is the one after the last jump
+    auto frame = podio::Frame(reader.readNextEntry("events"));
+    processEvent(frame, 5, reader.currentFileVersion());
+  }
+
+  std::filesystem::remove(largeFile);
+  return result;
+}
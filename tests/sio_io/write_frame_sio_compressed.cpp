@@ -0,0 +1,24 @@
+#include "write_frame.h"
+
+#include "podio/SIOWriter.h"
+
+#include <iostream>
+#include <stdexcept>
+
+int main(int, char**) {
+  try {
+    auto options = podio::WriterOptions{}.setCompression(podio::CompressionCodec::LZ4);
+    podio::SIOWriter writer("unsupported_compression.sio", options);
+    std::cerr << "Creating an SIOWriter with an unsupported compression codec should throw" << std::endl;
+    return 1;
+  } catch (const std::invalid_argument&) {
+  }
+
+  auto options = podio::WriterOptions{}.setCompression(podio::CompressionCodec::Zlib, 9);
+  options.setCompression("other_events", podio::CompressionCodec::None);
+  // Also make sure that compressing in parallel produces readable files
+  options.setCompressionThreads(4);
+
+  write_frames<podio::SIOWriter>("example_frame_compressed.sio", options);
+  return 0;
+}
@@ -0,0 +1,8 @@
+#include "write_frame.h"
+
+#include "podio/SIOWriter.h"
+
+int main(int, char**) {
+  write_frames_concurrent<podio::SIOWriter>("example_frame_concurrent.sio");
+  return 0;
+}
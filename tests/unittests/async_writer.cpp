@@ -0,0 +1,142 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "podio/AsyncWriter.h"
+#include "podio/Frame.h"
+
+#include "datamodel/ExampleHitCollection.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace {
+/// The state of a MockWriter, which is shared with the test since the writer
+/// itself is owned by the AsyncWriter
+struct MockWriterState {
+  std::mutex mtx{};
+  std::vector<std::tuple<std::string, int, size_t>> written{}; ///< category, frame index, number of hits
+  std::atomic<bool> blocked{false};                            ///< Whether writing should wait until unblocked
+  int failAt{-1};                                              ///< The frame index for which writing should throw
+  bool finished{false};
+  std::thread::id writerThread{};
+};
+
+/// A minimal writer that simply records what it has been asked to write
+struct MockWriter {
+  MockWriter(std::shared_ptr<MockWriterState> state) : m_state(std::move(state)) {
+  }
+
+  void writeFrame(const podio::Frame& frame, const std::string& category, const std::vector<std::string>&) {
+    while (m_state->blocked) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    const auto index = frame.getParameter<int>("index").value();
+    if (index == m_state->failAt) {
+      throw std::runtime_error("Failed to write frame " + std::to_string(index));
+    }
+    std::lock_guard lock{m_state->mtx};
+    m_state->written.emplace_back(category, index, frame.get<ExampleHitCollection>("hits").size());
+    m_state->writerThread = std::this_thread::get_id();
+  }
+
+  void finish() {
+    std::lock_guard lock{m_state->mtx};
+    m_state->finished = true;
+  }
+
+  std::shared_ptr<MockWriterState> m_state;
+};
+
+podio::Frame makeFrame(int index) {
+  auto frame = podio::Frame();
+  frame.putParameter("index", index);
+  auto hits = ExampleHitCollection();
+  for (int i = 0; i < index; ++i) {
+    hits.create();
+  }
+  frame.put(std::move(hits), "hits");
+  return frame;
+}
+} // namespace
+
+TEST_CASE("AsyncWriter writes in order on the I/O thread", "[async-writer]") {
+  auto state = std::make_shared<MockWriterState>();
+  {
+    auto mockWriter = podio::Writer{std::make_unique<MockWriter>(state)};
+    auto writer = podio::Writer{std::make_unique<podio::AsyncWriter>(std::move(mockWriter))};
+    for (int i = 0; i < 20; ++i) {
+      writer.writeEvent(makeFrame(i));
+    }
+    // Frames passed as const reference are written after all queued ones
+    const auto frame = makeFrame(20);
+    writer.writeFrame(frame, "runs");
+    writer.writeFrame(makeFrame(21), "runs");
+  }
+
+  REQUIRE(state->finished);
+  REQUIRE(state->written.size() == 22);
+  for (int i = 0; i < 22; ++i) {
+    const auto& [category, index, nHits] = state->written[i];
+    REQUIRE(category == (i < 20 ? "events" : "runs"));
+    REQUIRE(index == i);
+    REQUIRE(nHits == static_cast<size_t>(i));
+  }
+  REQUIRE(state->writerThread != std::this_thread::get_id());
+}
+
+TEST_CASE("AsyncWriter applies back-pressure", "[async-writer]") {
+  auto state = std::make_shared<MockWriterState>();
+  state->blocked = true;
+  auto writer = podio::AsyncWriter(podio::Writer{std::make_unique<MockWriter>(state)}, 2);
+
+  std::atomic<int> nQueued{0};
+  auto producer = std::thread([&]() {
+    for (int i = 0; i < 5; ++i) {
+      writer.writeFrame(makeFrame(i), "events");
+      nQueued++;
+    }
+  });
+
+  // One Frame is in the (blocked) writer and two are in the queue. All further
+  // ones have to wait
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  REQUIRE(nQueued <= 3);
+
+  state->blocked = false;
+  producer.join();
+  writer.finish();
+
+  REQUIRE(state->written.size() == 5);
+  const auto stats = writer.getStatistics();
+  REQUIRE(stats.nWritten == 5);
+  REQUIRE(stats.maxQueueDepth <= 2);
+  REQUIRE(stats.nWaits > 0);
+}
+
+TEST_CASE("AsyncWriter reports errors on the next call", "[async-writer]") {
+  auto state = std::make_shared<MockWriterState>();
+  state->failAt = 2;
+  auto writer = podio::AsyncWriter(podio::Writer{std::make_unique<MockWriter>(state)});
+
+  writer.writeFrame(makeFrame(0), "events");
+  writer.writeFrame(makeFrame(1), "events");
+  writer.writeFrame(makeFrame(2), "events");
+
+  // Drain the queue to make sure that the error has happened
+  const auto frame = makeFrame(3);
+  REQUIRE_THROWS_AS(writer.writeFrame(frame, "events"), std::runtime_error);
+
+  // The error is only reported once and writing continues afterwards
+  writer.writeFrame(makeFrame(4), "events");
+  writer.finish();
+  REQUIRE(state->finished);
+  REQUIRE(state->written.size() == 3);
+
+  REQUIRE_THROWS_AS(writer.writeFrame(makeFrame(5), "events"), std::runtime_error);
+}
@@ -1,12 +1,19 @@
 #include "datamodel/ExampleHitCollectionData.h"
 #include "podio/CollectionBufferFactory.h"
+#include "podio/ICollectionProvider.h"
+#include "podio/utilities/VectorPool.h"
 
 #include "datamodel/DatamodelDefinition.h"
 #include "datamodel/ExampleClusterCollection.h"
+#include "datamodel/ExampleHitCollection.h"
 #include "datamodel/ExampleWithVectorMemberCollection.h"
 
 #include "catch2/catch_test_macros.hpp"
 
+#include <map>
+#include <memory>
+#include <vector>
+
 TEST_CASE("createBuffers", "[internals][memory-management]") {
   const auto& factory = podio::CollectionBufferFactory::instance();
 
@@ -149,3 +156,199 @@ TEST_CASE("construct CollectionData non-empty buffers", "[internals][memory-mana
     auto collData = ExampleWithVectorMemberCollectionData(std::move(buffers), false);
   }
 }
+
+TEST_CASE("Collections from buffers create their objects on first access", "[internals][memory-management]") {
+  const auto& factory = podio::CollectionBufferFactory::instance();
+
+  SECTION("Type with contiguous storage") {
+    auto buffers = factory.createBuffers("ExampleHitCollection", datamodel::meta::schemaVersion, false).value();
+    auto dataBuffers = static_cast<ExampleHitDataContainer*>(buffers.data);
+    dataBuffers->emplace_back(ExampleHitData{0xcaffee, 1.0, 2.0, 3.0, 125.0});
+    dataBuffers->emplace_back(ExampleHitData{0xbeef, 4.0, 5.0, 6.0, 250.0});
+
+    auto coll = buffers.createCollection(buffers, false);
+    coll->prepareAfterRead();
+    // The collection ID is only set after preparing the collection
+    coll->setID(42);
+
+    auto& hits = static_cast<ExampleHitCollection&>(*coll);
+    REQUIRE(hits.size() == 2);
+    REQUIRE(hits[1].energy() == 250.0);
+    REQUIRE(hits[1].id() == podio::ObjectID{1, 42});
+
+    // Adding elements after reading keeps the ones that have been read
+    auto hit = hits.create();
+    REQUIRE(hit.id() == podio::ObjectID{2, 42});
+    REQUIRE(hits[0].cellID() == 0xcaffee);
+
+    hits.clear();
+    REQUIRE(hits.empty());
+  }
+
+  SECTION("Type with vector members") {
+    auto buffers =
+        factory.createBuffers("ExampleWithVectorMemberCollection", datamodel::meta::schemaVersion, false).value();
+    auto dataBuffers = static_cast<ExampleWithVectorMemberDataContainer*>(buffers.data);
+    dataBuffers->emplace_back(ExampleWithVectorMemberData{0, 2});
+    auto vecBuffer = static_cast<std::vector<int>*>((*buffers.vectorMembers)[0].second);
+    vecBuffer->emplace_back(42);
+    vecBuffer->emplace_back(123);
+
+    auto coll = buffers.createCollection(buffers, false);
+    coll->prepareAfterRead();
+    coll->setID(42);
+
+    auto& vecMemColl = static_cast<ExampleWithVectorMemberCollection&>(*coll);
+    auto elem = vecMemColl.create();
+    elem.addcount(1);
+
+    REQUIRE(vecMemColl.size() == 2);
+    REQUIRE(vecMemColl[0].count(1) == 123);
+    REQUIRE(vecMemColl[0].id() == podio::ObjectID{0, 42});
+    REQUIRE(vecMemColl[1].count(0) == 1);
+  }
+}
+
+TEST_CASE("Buffers are recycled", "[internals][memory-management]") {
+  const auto& factory = podio::CollectionBufferFactory::instance();
+
+  SECTION("Buffers of destroyed collections") {
+    auto buffers = factory.createBuffers("ExampleHitCollection", datamodel::meta::schemaVersion, false).value();
+    auto dataBuffers = static_cast<ExampleHitDataContainer*>(buffers.data);
+    dataBuffers->reserve(100);
+    dataBuffers->emplace_back(ExampleHitData{0xcaffee, 1.0, 2.0, 3.0, 125.0});
+    {
+      auto coll = buffers.createCollection(buffers, false);
+      coll->prepareAfterRead();
+    }
+
+    auto newBuffers = factory.createBuffers("ExampleHitCollection", datamodel::meta::schemaVersion, false).value();
+    auto newDataBuffers = static_cast<ExampleHitDataContainer*>(newBuffers.data);
+    REQUIRE(newDataBuffers == dataBuffers);
+    REQUIRE(newDataBuffers->empty());
+    REQUIRE(newDataBuffers->capacity() >= 100);
+
+    newBuffers.deleteBuffers(newBuffers);
+  }
+
+  SECTION("Buffers that have not been turned into a collection") {
+    auto buffers = factory.createBuffers("ExampleClusterCollection", datamodel::meta::schemaVersion, false).value();
+    auto dataBuffers = static_cast<ExampleClusterDataContainer*>(buffers.data);
+    dataBuffers->emplace_back(ExampleClusterData{125.0});
+    (*buffers.references)[0]->emplace_back(podio::ObjectID{42, 42});
+    buffers.deleteBuffers(buffers);
+
+    auto newBuffers = factory.createBuffers("ExampleClusterCollection", datamodel::meta::schemaVersion, false).value();
+    auto newDataBuffers = static_cast<ExampleClusterDataContainer*>(newBuffers.data);
+    REQUIRE(newDataBuffers == dataBuffers);
+    REQUIRE(newDataBuffers->empty());
+    for (const auto& refs : *newBuffers.references) {
+      REQUIRE(refs->empty());
+    }
+
+    newBuffers.deleteBuffers(newBuffers);
+  }
+}
+
+/// Collection provider that counts how often each collection is requested
+struct CountingCollectionProvider : public podio::ICollectionProvider {
+  std::map<uint32_t, podio::CollectionBase*> collections{};
+  mutable std::map<uint32_t, int> requests{};
+
+  bool get(uint32_t collectionID, podio::CollectionBase*& collection) const override {
+    requests[collectionID]++;
+    if (const auto it = collections.find(collectionID); it != collections.end()) {
+      collection = it->second;
+      return true;
+    }
+    return false;
+  }
+};
+
+TEST_CASE("Relations resolve every collection only once", "[internals][relations]") {
+  const auto& factory = podio::CollectionBufferFactory::instance();
+
+  auto hits = ExampleHitCollection();
+  hits.create(0xcaffeeULL, 1.0, 2.0, 3.0, 1.0);
+  hits.create(0xcaffeeULL, 1.0, 2.0, 3.0, 2.0);
+  hits.create(0xcaffeeULL, 1.0, 2.0, 3.0, 3.0);
+  hits.setID(1);
+
+  auto buffers = factory.createBuffers("ExampleClusterCollection", datamodel::meta::schemaVersion, false).value();
+  auto dataBuffers = static_cast<ExampleClusterDataContainer*>(buffers.data);
+  dataBuffers->emplace_back(ExampleClusterData{1.0, 0, 3, 0, 0});
+  dataBuffers->emplace_back(ExampleClusterData{2.0, 3, 5, 0, 0});
+  // The last ObjectID points into a collection that is not available
+  auto& hitRefs = *(*buffers.references)[0];
+  hitRefs = {{0, 1}, {1, 1}, {2, 1}, {0, 1}, {0, 99}};
+
+  auto coll = buffers.createCollection(buffers, false);
+  coll->prepareAfterRead();
+  coll->setID(2);
+
+  auto provider = CountingCollectionProvider();
+  provider.collections.emplace(1, &hits);
+  coll->setReferences(&provider);
+
+  REQUIRE(provider.requests[1] == 1);
+  REQUIRE(provider.requests[99] == 1);
+
+  const auto& clusters = static_cast<ExampleClusterCollection&>(*coll);
+  REQUIRE(clusters[0].Hits().size() == 3);
+  REQUIRE(clusters[0].Hits(2) == hits[2]);
+  REQUIRE(clusters[1].Hits(0) == hits[0]);
+  REQUIRE_FALSE(clusters[1].Hits(1).isAvailable());
+}
+
+namespace {
+/// A type that is not used by any collection, such that the pool is not
+/// touched by other tests
+struct PoolTestElement {
+  char bytes[1024];
+};
+} // namespace
+
+TEST_CASE("VectorPool limits the memory it keeps", "[internals][memory-management]") {
+  auto& pool = podio::utils::VectorPool<PoolTestElement>::instance();
+  pool.clear();
+  pool.setMaxVectorBytes(16 * sizeof(PoolTestElement));
+  pool.setMaxBytes(32 * sizeof(PoolTestElement));
+
+  const auto makeVec = [](size_t capacity) {
+    auto vec = std::make_unique<std::vector<PoolTestElement>>();
+    vec->reserve(capacity);
+    return vec;
+  };
+
+  // Vectors that have grown too large are not kept
+  pool.release(makeVec(17));
+  REQUIRE(pool.size() == 0);
+  REQUIRE(pool.retainedBytes() == 0);
+
+  pool.release(makeVec(16));
+  pool.release(makeVec(8));
+  REQUIRE(pool.size() == 2);
+  REQUIRE(pool.retainedBytes() == 24 * sizeof(PoolTestElement));
+
+  // Nor are vectors that would go beyond the total limit
+  pool.release(makeVec(10));
+  REQUIRE(pool.size() == 2);
+
+  // Acquiring reuses the kept vectors and their capacity
+  auto vec = pool.acquire();
+  REQUIRE(vec->capacity() == 8);
+  REQUIRE(pool.retainedBytes() == 16 * sizeof(PoolTestElement));
+  pool.release(std::move(vec));
+
+  // Trimming deletes the largest vectors first
+  pool.trim(10 * sizeof(PoolTestElement));
+  REQUIRE(pool.size() == 1);
+  REQUIRE(pool.retainedBytes() == 8 * sizeof(PoolTestElement));
+
+  pool.clear();
+  REQUIRE(pool.size() == 0);
+  REQUIRE(pool.retainedBytes() == 0);
+
+  pool.setMaxVectorBytes(podio::utils::VectorPool<PoolTestElement>::defaultMaxVectorBytes);
+  pool.setMaxBytes(podio::utils::VectorPool<PoolTestElement>::defaultMaxBytes);
+}
@@ -1,7 +1,9 @@
+#include "podio/CollectionBufferFactory.h"
 #include "podio/Frame.h"
 
 #include "catch2/catch_test_macros.hpp"
 
+#include "datamodel/DatamodelDefinition.h"
 #include "datamodel/ExampleClusterCollection.h"
 #include "datamodel/ExampleHitCollection.h"
 
@@ -443,3 +445,214 @@ TEST_CASE("EIC-Jana2 cleanup use case", "[memory-management][492][174]") {
   }
   delete clone;
 }
+
+/// Minimal FrameData that hands out buffers that have been filled in memory
+struct BufferFrameData {
+  std::map<std::string, podio::CollectionReadBuffers> buffers{};
+  podio::CollectionIDTable idTable{};
+  podio::CollectionSizeIndex collSizes{};
+
+  BufferFrameData() = default;
+  BufferFrameData(const BufferFrameData&) = delete;
+  BufferFrameData& operator=(const BufferFrameData&) = delete;
+  BufferFrameData(BufferFrameData&&) = default;
+  BufferFrameData& operator=(BufferFrameData&&) = default;
+
+  ~BufferFrameData() {
+    for (auto& [_, buffer] : buffers) {
+      buffer.deleteBuffers(buffer);
+    }
+  }
+
+  podio::CollectionIDTable getIDTable() const {
+    return {idTable.ids(), idTable.names()};
+  }
+
+  std::optional<podio::CollectionReadBuffers> getCollectionBuffers(const std::string& name) {
+    auto node = buffers.extract(name);
+    if (node.empty()) {
+      return std::nullopt;
+    }
+    return node.mapped();
+  }
+
+  std::vector<std::string> getAvailableCollections() const {
+    std::vector<std::string> names;
+    for (const auto& [name, _] : buffers) {
+      names.push_back(name);
+    }
+    return names;
+  }
+
+  std::unique_ptr<podio::GenericParameters> getParameters() {
+    return std::make_unique<podio::GenericParameters>();
+  }
+
+  const podio::CollectionSizeIndex& getCollectionSizes() const {
+    return collSizes;
+  }
+};
+
+BufferFrameData createBufferFrameData() {
+  const auto& factory = podio::CollectionBufferFactory::instance();
+  BufferFrameData data;
+  const auto hitsID = data.idTable.add("hits");
+  data.idTable.add("clusters");
+  data.idTable.add("otherHits");
+
+  for (const auto& name : {"hits", "otherHits"}) {
+    auto hitBuffers = factory.createBuffers("ExampleHitCollection", datamodel::meta::schemaVersion, false).value();
+    auto hitData = hitBuffers.dataAsVector<ExampleHitData>();
+    hitData->push_back({0xcaffee, 1.0, 2.0, 3.0, 125.0});
+    hitData->push_back({0xbeef, 4.0, 5.0, 6.0, 250.0});
+    data.buffers.emplace(name, hitBuffers);
+  }
+
+  auto clusterBuffers =
+      factory.createBuffers("ExampleClusterCollection", datamodel::meta::schemaVersion, false).value();
+  clusterBuffers.dataAsVector<ExampleClusterData>()->push_back({375.0, 0, 1, 0, 0});
+  (*clusterBuffers.references)[0]->emplace_back(1, hitsID);
+  data.buffers.emplace("clusters", clusterBuffers);
+
+  return data;
+}
+
+TEST_CASE("Frame prefetch", "[frame][basics][multithread]") {
+  SECTION("Related collections are unpacked as well") {
+    const auto frame = podio::Frame(createBufferFrameData());
+    frame.prefetch({"clusters", "notAvailable"}, 2);
+
+    const auto& clusters = frame.get<ExampleClusterCollection>("clusters");
+    const auto& hits = frame.get<ExampleHitCollection>("hits");
+    REQUIRE(clusters.size() == 1);
+    REQUIRE(hits.size() == 2);
+    REQUIRE(clusters[0].Hits(0) == hits[1]);
+    REQUIRE(clusters[0].Hits(0).cellID() == 0xbeef);
+
+    // Unrelated collections are still available for unpacking on demand
+    REQUIRE(frame.get<ExampleHitCollection>("otherHits").size() == 2);
+  }
+
+  SECTION("All collections") {
+    const auto frame = podio::Frame(createBufferFrameData());
+    // Collections that are already unpacked are not touched again
+    const auto& hits = frame.get<ExampleHitCollection>("hits");
+    frame.prefetchAll();
+
+    REQUIRE(frame.getAvailableCollections().size() == 3);
+    REQUIRE(&frame.get<ExampleHitCollection>("hits") == &hits);
+    REQUIRE(frame.get<ExampleClusterCollection>("clusters")[0].Hits(0) == hits[1]);
+    REQUIRE(frame.get<ExampleHitCollection>("otherHits")[0].energy() == 125.0);
+  }
+
+  SECTION("Passed pool") {
+    auto pool = podio::utils::ThreadPool(2);
+    const auto frame = podio::Frame(createBufferFrameData());
+    frame.prefetch({"clusters"}, pool);
+    REQUIRE(frame.get<ExampleClusterCollection>("clusters")[0].Hits(0).cellID() == 0xbeef);
+
+    frame.prefetchAll(pool);
+    REQUIRE(frame.get<ExampleHitCollection>("otherHits")[0].energy() == 125.0);
+  }
+
+  SECTION("Frame without raw data") {
+    auto frame = podio::Frame();
+    auto hits = ExampleHitCollection();
+    hits.create();
+    frame.put(std::move(hits), "hits");
+
+    frame.prefetchAll();
+    REQUIRE(frame.get<ExampleHitCollection>("hits").size() == 1);
+  }
+}
+
+TEST_CASE("Frame prefetch and concurrent get", "[frame][basics][multithread]") {
+  // Run this a few times, since the window in which the collections are
+  // neither in the raw data nor unpacked is short
+  constexpr int nRepetitions = 200;
+  int successes = 0;
+  for (int i = 0; i < nRepetitions; ++i) {
+    const auto frame = podio::Frame(createBufferFrameData());
+    // Assertions are not threadsafe, so only collect the results in the
+    // threads and check them afterwards
+    size_t nHits = 0;
+    bool relationsOk = false;
+    auto getThread = std::thread([&]() {
+      const auto& hits = frame.get<ExampleHitCollection>("hits");
+      nHits = hits.size();
+      const auto& clusters = frame.get<ExampleClusterCollection>("clusters");
+      relationsOk = clusters.size() == 1 && clusters[0].Hits(0) == hits[1];
+    });
+    frame.prefetch({"clusters"}, 2);
+    getThread.join();
+
+    CHECK_INCREASE(nHits == 2 && relationsOk, successes);
+  }
+  REQUIRE(successes == nRepetitions);
+}
+
+TEST_CASE("Frame collection tokens", "[frame][basics]") {
+  const auto frame = podio::Frame(createBufferFrameData());
+  const auto hitsToken = frame.getToken<ExampleHitCollection>("hits");
+  REQUIRE(hitsToken.isValid());
+  REQUIRE(hitsToken.name() == "hits");
+  REQUIRE(hitsToken.index() == 0);
+
+  const auto& hits = frame.get(hitsToken);
+  REQUIRE(&hits == &frame.get<ExampleHitCollection>("hits"));
+  REQUIRE(hits[1].cellID() == 0xbeef);
+
+  // Tokens can be used for all Frames with the same collection ID table
+  const auto otherFrame = podio::Frame(createBufferFrameData());
+  const auto clustersToken = frame.getToken<ExampleClusterCollection>("clusters");
+  const auto& clusters = otherFrame.get(clustersToken);
+  REQUIRE(clusters.size() == 1);
+  REQUIRE(&otherFrame.get(clustersToken) == &clusters);
+  REQUIRE(clusters[0].Hits(0) == otherFrame.get(hitsToken)[1]);
+
+  // Frames with a different collection ID table get the collection by name
+  auto putFrame = podio::Frame();
+  auto otherHits = ExampleHitCollection();
+  otherHits.create();
+  putFrame.put(std::move(otherHits), "otherHits");
+  putFrame.put(ExampleHitCollection(), "hits");
+  REQUIRE(putFrame.get(hitsToken).empty());
+  REQUIRE(putFrame.get(frame.getToken<ExampleHitCollection>("otherHits")).size() == 1);
+
+  REQUIRE_FALSE(frame.getToken<ExampleHitCollection>("notAvailable").isValid());
+  REQUIRE(frame.get(podio::CollectionToken<ExampleHitCollection>{}).empty());
+  REQUIRE_THROWS_AS(frame.getToken<ExampleClusterCollection>("hits"), std::invalid_argument);
+}
+
+TEST_CASE("Frame collection sizes", "[frame][basics]") {
+  auto data = createBufferFrameData();
+  // Something that cannot be determined from the buffers to make sure that the
+  // index is used where available
+  data.collSizes.emplace("hits", podio::CollectionSizeInfo{"ExampleHit", 2, 42});
+  auto frame = podio::Frame(std::move(data));
+
+  const auto hitsSize = frame.getCollectionSize("hits");
+  REQUIRE(hitsSize.has_value());
+  REQUIRE(hitsSize->valueType == "ExampleHit");
+  REQUIRE(hitsSize->elements == 2);
+  REQUIRE(hitsSize->bytes == 42);
+
+  // Collections that are not in the index are determined from the collection,
+  // without preparing it for writing, i.e. without knowing the buffer size
+  const auto clustersSize = frame.getCollectionSize("clusters");
+  REQUIRE(clustersSize.has_value());
+  REQUIRE(clustersSize->valueType == "ExampleCluster");
+  REQUIRE(clustersSize->elements == 1);
+  REQUIRE_FALSE(clustersSize->bytes.has_value());
+
+  auto hits = ExampleHitCollection();
+  hits.create();
+  frame.put(std::move(hits), "putHits");
+  const auto putSize = frame.getCollectionSize("putHits");
+  REQUIRE(putSize.has_value());
+  REQUIRE(putSize->valueType == "ExampleHit");
+  REQUIRE(putSize->elements == 1);
+  REQUIRE_FALSE(putSize->bytes.has_value());
+
+  REQUIRE_FALSE(frame.getCollectionSize("notAvailable").has_value());
+}
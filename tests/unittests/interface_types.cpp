@@ -1,7 +1,9 @@
 #include "catch2/catch_test_macros.hpp"
 
+#include "datamodel/ExampleClusterCollection.h"
 #include "datamodel/ExampleHit.h"
 #include "datamodel/ExampleHitCollection.h"
+#include "datamodel/ExampleWithVectorMemberCollection.h"
 #include "datamodel/MutableExampleCluster.h"
 #include "datamodel/MutableExampleMC.h"
 #include "datamodel/TypeWithEnergy.h"
@@ -10,10 +12,13 @@
 #include "interface_extension_model/EnergyInterface.h"
 #include "interface_extension_model/MutableAnotherHit.h"
 
+#include "podio/ICollectionProvider.h"
 #include "podio/ObjectID.h"
+#include "podio/detail/RelationIOHelpers.h"
 #include "podio/utilities/TypeHelpers.h"
 
 #include <map>
+#include <memory>
 #include <stdexcept>
 #include <utility>
 #include <vector>
@@ -158,3 +163,115 @@ TEST_CASE("InterfaceType extension model", "[interface-types][extension]") {
   REQUIRE(wrapper.isA<iextension::AnotherHit>());
   REQUIRE(wrapper.as<iextension::AnotherHit>().energy() == 4.2f);
 }
+
+/// Collection provider for a fixed set of collections
+struct MapCollectionProvider : public podio::ICollectionProvider {
+  std::map<uint32_t, podio::CollectionBase*> collections{};
+
+  bool get(uint32_t collectionID, podio::CollectionBase*& collection) const override {
+    if (const auto it = collections.find(collectionID); it != collections.end()) {
+      collection = it->second;
+      return true;
+    }
+    return false;
+  }
+};
+
+/// The collections that the relation tests point into
+struct RelationTestCollections {
+  RelationTestCollections() {
+    hits.setID(1);
+    hit = hits.create();
+    hit.energy(1.23f);
+    clusters.setID(2);
+    cluster = clusters.create();
+    cluster.energy(4.56f);
+  }
+
+  ExampleHitCollection hits{};
+  ExampleClusterCollection clusters{};
+  ExampleWithVectorMemberCollection others{};
+  MutableExampleHit hit{};
+  MutableExampleCluster cluster{};
+};
+
+TEST_CASE("InterfaceType relation resolution", "[interface-types][relations]") {
+  auto [hits, clusters, others, hit, cluster] = RelationTestCollections();
+
+  // The interfaced type is determined from the type name of the collection
+  REQUIRE(podio::detail::getInterfacedTypeIndex<TypeWithEnergy>(&hits) == 0);
+  REQUIRE(podio::detail::getInterfacedTypeIndex<TypeWithEnergy>(&clusters) == 2);
+  REQUIRE(podio::detail::getInterfacedTypeIndex<TypeWithEnergy>(&others) == 3);
+
+  auto typeResolver = podio::detail::InterfaceTypeResolver<TypeWithEnergy>{};
+  auto relations = std::vector<TypeWithEnergy>{};
+  podio::detail::addMultiRelation(relations, &hits, hit.id(), typeResolver);
+  podio::detail::addMultiRelation(relations, &clusters, cluster.id(), typeResolver);
+  podio::detail::addMultiRelation(relations, &hits, hit.id(), typeResolver);
+  // Elements of collections of non-interfaced types are not added
+  podio::detail::addMultiRelation(relations, &others, podio::ObjectID{0, 3}, typeResolver);
+
+  REQUIRE(relations.size() == 3);
+  REQUIRE(relations[0].isA<ExampleHit>());
+  REQUIRE(relations[0] == hit);
+  REQUIRE(relations[1].isA<ExampleCluster>());
+  REQUIRE(relations[1].energy() == 4.56f);
+  REQUIRE(relations[2] == relations[0]);
+
+  auto single = std::unique_ptr<TypeWithEnergy>{};
+  podio::detail::addSingleRelation(single, &clusters, cluster.id(), typeResolver);
+  REQUIRE(single);
+  REQUIRE(*single == cluster);
+}
+
+TEST_CASE("InlineRelation", "[relations]") {
+  auto [hits, clusters, others, hit, cluster] = RelationTestCollections();
+  auto typeResolver = podio::detail::InterfaceTypeResolver<TypeWithEnergy>{};
+
+  // Inline relations only create the handle when it is requested
+  auto inlined = podio::detail::InlineRelation<TypeWithEnergy>{};
+  REQUIRE_FALSE(inlined);
+  REQUIRE(inlined.getObjectID().index == podio::ObjectID::invalid);
+  podio::detail::addSingleRelation(inlined, &hits, hit.id(), typeResolver);
+  REQUIRE(inlined);
+  REQUIRE(inlined.getObjectID() == hit.id());
+  REQUIRE(inlined.get().isA<ExampleHit>());
+  REQUIRE(inlined.get() == hit);
+  auto copied = inlined;
+  copied.set(cluster);
+  REQUIRE(copied.get() == cluster);
+  REQUIRE(inlined.get() == hit);
+}
+
+TEST_CASE("RelationTable", "[relations]") {
+  auto [hits, clusters, others, hit, cluster] = RelationTestCollections();
+  auto typeResolver = podio::detail::InterfaceTypeResolver<TypeWithEnergy>{};
+  auto provider = MapCollectionProvider();
+  provider.collections = {{1, &hits}, {2, &clusters}, {3, &others}};
+  auto collResolver = podio::detail::CollectionResolver(&provider);
+
+  // Relation tables only resolve the collections and create the handles on
+  // demand
+  auto ids = std::vector<podio::ObjectID>{hit.id(), cluster.id(), {podio::ObjectID::invalid, 0}, {0, 3}, {0, 42}};
+  auto table = podio::detail::RelationTable<TypeWithEnergy>(&ids);
+  podio::detail::resolveRelationTable(table, ids, collResolver, typeResolver);
+  REQUIRE(table.hasTarget(1));
+  REQUIRE(table.hasTarget(2));
+  REQUIRE(table.get(0) == hit);
+  REQUIRE(table.get(1).isA<ExampleCluster>());
+  REQUIRE(table.get(1).energy() == 4.56f);
+  // Invalid ObjectIDs, non-interfaced types and missing collections give empty handles
+  REQUIRE_FALSE(table.get(2).isAvailable());
+  REQUIRE_FALSE(table.get(3).isAvailable());
+  REQUIRE_FALSE(table.get(4).isAvailable());
+
+  auto it = podio::detail::RelationTableIterator<TypeWithEnergy>(&table, nullptr, 1);
+  REQUIRE(it->energy() == 4.56f);
+
+  // The lookup does not depend on the order in which the collections appear
+  auto reversedIds = std::vector<podio::ObjectID>{cluster.id(), hit.id()};
+  auto reversedTable = podio::detail::RelationTable<TypeWithEnergy>(&reversedIds);
+  podio::detail::resolveRelationTable(reversedTable, reversedIds, collResolver, typeResolver);
+  REQUIRE(reversedTable.get(0).isA<ExampleCluster>());
+  REQUIRE(reversedTable.get(1) == hit);
+}
@@ -4,6 +4,8 @@
 
 #include "podio/LinkCollection.h"
 #include "podio/RelationRange.h"
+#include "podio/StridedSpan.h"
+#include "podio/detail/RelationTable.h"
 
 #include <catch2/catch_test_macros.hpp>
 
@@ -497,6 +499,81 @@ TEST_CASE("Collection and iterator concepts", "[collection][container][iterator]
     // const_iterator
     STATIC_REQUIRE(std::input_iterator<const_iterator>);
   }
+
+  SECTION("forward_iterator") {
+    // iterator
+    STATIC_REQUIRE(std::forward_iterator<iterator>);
+    // const_iterator
+    STATIC_REQUIRE(std::forward_iterator<const_iterator>);
+    {
+      auto coll = CollectionType();
+      coll.create().cellID(42);
+      coll.create().cellID(43);
+      // multi-pass
+      auto a = coll.cbegin();
+      auto b = a;
+      REQUIRE((*a).cellID() == 42);
+      ++a;
+      REQUIRE((*b).cellID() == 42);
+      REQUIRE((*a).cellID() == 43);
+      REQUIRE(++b == a);
+    }
+  }
+
+  SECTION("bidirectional_iterator") {
+    // iterator
+    STATIC_REQUIRE(std::bidirectional_iterator<iterator>);
+    // const_iterator
+    STATIC_REQUIRE(std::bidirectional_iterator<const_iterator>);
+    {
+      auto coll = CollectionType();
+      coll.create().cellID(42);
+      coll.create().cellID(43);
+      auto it = coll.end();
+      REQUIRE((*--it).cellID() == 43);
+      REQUIRE((*it--).cellID() == 43);
+      REQUIRE(it == coll.begin());
+    }
+  }
+
+  SECTION("random_access_iterator") {
+    // iterator
+    STATIC_REQUIRE(std::random_access_iterator<iterator>);
+    // const_iterator
+    STATIC_REQUIRE(std::random_access_iterator<const_iterator>);
+    {
+      auto coll = CollectionType();
+      for (unsigned i = 0; i < 5; ++i) {
+        coll.create().cellID(i);
+      }
+      auto it = coll.cbegin();
+      REQUIRE(coll.cend() - it == 5);
+      REQUIRE(it - coll.cend() == -5);
+      REQUIRE((it + 3)->cellID() == 3);
+      REQUIRE((3 + it)->cellID() == 3);
+      REQUIRE(it[4].cellID() == 4);
+      it += 4;
+      REQUIRE((it - 1)->cellID() == 3);
+      it -= 2;
+      REQUIRE(it->cellID() == 2);
+      REQUIRE(it < coll.cend());
+      REQUIRE(it > coll.cbegin());
+      REQUIRE(it <= it);
+      REQUIRE(it >= it);
+      REQUIRE(coll.begin()[2].cellID() == 2);
+    }
+  }
+
+  SECTION("iterator_concept") {
+    // The c++20 concepts use the iterator_concept, while the legacy
+    // iterator_category stays that of an input iterator
+    // iterator
+    STATIC_REQUIRE(std::is_same_v<iterator::iterator_concept, std::random_access_iterator_tag>);
+    STATIC_REQUIRE(std::is_same_v<std::iterator_traits<iterator>::iterator_category, std::input_iterator_tag>);
+    // const_iterator
+    STATIC_REQUIRE(std::is_same_v<const_iterator::iterator_concept, std::random_access_iterator_tag>);
+    STATIC_REQUIRE(std::is_same_v<std::iterator_traits<const_iterator>::iterator_category, std::input_iterator_tag>);
+  }
 }
 
 TEST_CASE("Collection and unsupported iterator concepts", "[collection][container][iterator][std]") {
@@ -510,15 +587,6 @@ TEST_CASE("Collection and unsupported iterator concepts", "[collection][containe
   DOCUMENTED_STATIC_FAILURE(std::output_iterator<iterator, CollectionType::mutable_type>);
   DOCUMENTED_STATIC_FAILURE(std::output_iterator<const_iterator, CollectionType::value_type>);
   DOCUMENTED_STATIC_FAILURE(std::output_iterator<const_iterator, CollectionType::mutable_type>);
-  // std::forward_iterator
-  DOCUMENTED_STATIC_FAILURE(std::forward_iterator<iterator>);
-  DOCUMENTED_STATIC_FAILURE(std::forward_iterator<const_iterator>);
-  // std::bidirectional_iterator
-  DOCUMENTED_STATIC_FAILURE(std::bidirectional_iterator<iterator>);
-  DOCUMENTED_STATIC_FAILURE(std::bidirectional_iterator<const_iterator>);
-  // std::random_access_iterator
-  DOCUMENTED_STATIC_FAILURE(std::random_access_iterator<iterator>);
-  DOCUMENTED_STATIC_FAILURE(std::random_access_iterator<const_iterator>);
   // std::contiguous_iterator
   DOCUMENTED_STATIC_FAILURE(std::contiguous_iterator<iterator>);
   DOCUMENTED_STATIC_FAILURE(std::contiguous_iterator<const_iterator>);
@@ -924,15 +992,32 @@ TEST_CASE("Collection and std iterator adaptors", "[collection][container][adapt
     STATIC_REQUIRE(traits::has_iterator_category_v<std::iterator_traits<iterator>>);
     DOCUMENTED_STATIC_FAILURE(
         std::is_base_of_v<std::bidirectional_iterator_tag, std::iterator_traits<iterator>::iterator_category>);
-    DOCUMENTED_STATIC_FAILURE(std::bidirectional_iterator<iterator>);
-    // TODO add runtime checks here
+    // std::reverse_iterator also works with std::bidirectional_iterator
+    STATIC_REQUIRE(std::bidirectional_iterator<iterator>);
+    {
+      auto coll = CollectionType();
+      coll.create().cellID(42);
+      coll.create().cellID(43);
+      auto rit = std::make_reverse_iterator(coll.end());
+      REQUIRE((*rit).cellID() == 43);
+      REQUIRE((*++rit).cellID() == 42);
+      REQUIRE(++rit == std::make_reverse_iterator(coll.begin()));
+    }
     // const_iterator
     STATIC_REQUIRE(traits::has_const_iterator_v<CollectionType>);
     STATIC_REQUIRE(traits::has_iterator_category_v<std::iterator_traits<const_iterator>>);
     DOCUMENTED_STATIC_FAILURE(
         std::is_base_of_v<std::bidirectional_iterator_tag, std::iterator_traits<const_iterator>::iterator_category>);
-    DOCUMENTED_STATIC_FAILURE(std::bidirectional_iterator<iterator>);
-    // TODO add runtime checks here
+    STATIC_REQUIRE(std::bidirectional_iterator<const_iterator>);
+    {
+      auto coll = CollectionType();
+      coll.create().cellID(42);
+      coll.create().cellID(43);
+      auto rit = std::make_reverse_iterator(coll.cend());
+      REQUIRE((*rit).cellID() == 43);
+      REQUIRE((*++rit).cellID() == 42);
+      REQUIRE(++rit == std::make_reverse_iterator(coll.cbegin()));
+    }
   }
   SECTION("Back inserter") {
     DOCUMENTED_STATIC_FAILURE(traits::has_const_reference_v<CollectionType>);
@@ -1087,11 +1172,11 @@ TEST_CASE("Collection as range", "[collection][ranges][std]") {
   DOCUMENTED_STATIC_FAILURE(std::ranges::output_range<CollectionType, CollectionType::value_type>);
   DOCUMENTED_STATIC_FAILURE(std::ranges::output_range<CollectionType, CollectionType::mutable_type>);
   // std::range::forward_range
-  DOCUMENTED_STATIC_FAILURE(std::ranges::forward_range<CollectionType>);
+  STATIC_REQUIRE(std::ranges::forward_range<CollectionType>);
   // std::range::bidirectional_range
-  DOCUMENTED_STATIC_FAILURE(std::ranges::bidirectional_range<CollectionType>);
+  STATIC_REQUIRE(std::ranges::bidirectional_range<CollectionType>);
   // std::range::random_access_range
-  DOCUMENTED_STATIC_FAILURE(std::ranges::random_access_range<CollectionType>);
+  STATIC_REQUIRE(std::ranges::random_access_range<CollectionType>);
   // std::range::contiguous_range
   DOCUMENTED_STATIC_FAILURE(std::ranges::contiguous_range<CollectionType>);
   // std::range::common_range
@@ -1156,13 +1241,14 @@ TEST_CASE("Collection and std ranges algorithms", "[collection][ranges][std]") {
   REQUIRE(subcoll.size() == 2);
   REQUIRE(subcoll[0].cellID() == 5);
   REQUIRE(subcoll[1].cellID() == 3);
-}
 
-// helper concept for unsupported algorithm compilation test
-template <typename T>
-concept is_range_adjacent_findable = requires(T coll) {
-  std::ranges::adjacent_find(coll, [](const auto& a, const auto& b) { return a.cellID() == b.cellID(); });
-};
+  // std::ranges::adjacent_find
+  auto adjIt = std::ranges::adjacent_find(coll, [](const auto& a, const auto& b) { return a.cellID() == b.cellID(); });
+  REQUIRE(adjIt == std::begin(coll) + 2);
+
+  // std::ranges::max_element
+  REQUIRE(std::ranges::max_element(coll, {}, [](const auto& x) { return x.cellID(); })->cellID() == 5);
+}
 
 // helper concept for unsupported algorithm compilation test
 template <typename T>
@@ -1175,7 +1261,6 @@ concept is_range_fillable = requires(T coll) { std::ranges::fill(coll, typename
 
 TEST_CASE("Collection and unsupported std ranges algorithms", "[collection][ranges][std]") {
   // check that algorithms requiring unsupported iterator concepts won't compile
-  DOCUMENTED_STATIC_FAILURE(is_range_adjacent_findable<CollectionType>);
   DOCUMENTED_STATIC_FAILURE(is_range_sortable<CollectionType>);
   DOCUMENTED_STATIC_FAILURE(is_range_fillable<CollectionType>);
 }
@@ -1208,5 +1293,33 @@ TEST_CASE("RelationRange as range", "[relations][ranges][std]") {
   STATIC_REQUIRE(std::ranges::borrowed_range<relation_range>);
 }
 
+TEST_CASE("RelationRange of lazy relations as range", "[relations][ranges][std]") {
+  using iterator = podio::detail::RelationTableIterator<ExampleHit>;
+  using relation_range = podio::RelationRange<ExampleHit, iterator>;
+
+  STATIC_REQUIRE(std::is_same_v<iterator::iterator_category, std::input_iterator_tag>);
+  STATIC_REQUIRE(std::is_same_v<iterator::iterator_concept, std::random_access_iterator_tag>);
+  STATIC_REQUIRE(std::random_access_iterator<iterator>);
+  STATIC_REQUIRE(std::ranges::random_access_range<relation_range>);
+  STATIC_REQUIRE(std::ranges::sized_range<relation_range>);
+  STATIC_REQUIRE(std::ranges::common_range<relation_range>);
+  STATIC_REQUIRE(std::ranges::viewable_range<relation_range>);
+  STATIC_REQUIRE(std::ranges::view<relation_range>);
+  STATIC_REQUIRE(std::ranges::borrowed_range<relation_range>);
+}
+
+TEST_CASE("StridedSpan as range", "[collection][ranges][std]") {
+  using column = podio::StridedSpan<const double>;
+
+  STATIC_REQUIRE(std::random_access_iterator<column::iterator>);
+  STATIC_REQUIRE(std::ranges::random_access_range<column>);
+  STATIC_REQUIRE(std::ranges::sized_range<column>);
+  STATIC_REQUIRE(std::ranges::common_range<column>);
+  STATIC_REQUIRE(std::ranges::viewable_range<column>);
+  STATIC_REQUIRE(std::ranges::view<column>);
+  STATIC_REQUIRE(std::ranges::borrowed_range<column>);
+  STATIC_REQUIRE(std::is_same_v<decltype(std::declval<ExampleHitCollection>().energy_column()), column>);
+}
+
 #undef DOCUMENTED_STATIC_FAILURE
 #undef DOCUMENTED_FAILURE
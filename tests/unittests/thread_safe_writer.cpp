@@ -0,0 +1,199 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "podio/ThreadSafeWriter.h"
+#include "podio/Frame.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+/// The state of the mock writers, which is shared with the test since the
+/// writers themselves are owned by the ThreadSafeWriter
+struct MockWriterState {
+  std::mutex mtx{};
+  std::vector<std::pair<std::string, int>> written{}; ///< category and frame index
+  std::atomic<int> nWriting{0};                       ///< The number of threads that are currently writing
+  std::atomic<bool> overlapped{false};                ///< Whether writing has ever been done concurrently
+  std::atomic<int> nEncoded{0};                       ///< The number of encoded frames
+  int failAt{-1};                                     ///< The frame index for which encoding should throw
+  bool finished{false};
+
+  void write(const std::string& category, int index) {
+    if (nWriting++ > 0) {
+      overlapped = true;
+    }
+    std::this_thread::yield();
+    {
+      std::lock_guard lock{mtx};
+      written.emplace_back(category, index);
+    }
+    nWriting--;
+  }
+};
+
+/// A minimal writer that simply records what it has been asked to write
+struct MockWriter {
+  MockWriter(std::shared_ptr<MockWriterState> state) : m_state(std::move(state)) {
+  }
+
+  void writeFrame(const podio::Frame& frame, const std::string& category, const std::vector<std::string>&) {
+    m_state->write(category, frame.getParameter<int>("index").value());
+  }
+
+  void finish() {
+    m_state->finished = true;
+  }
+
+  std::shared_ptr<MockWriterState> m_state;
+};
+
+/// A minimal writer that splits writing into encoding and the actual writing
+struct MockEncodingWriter {
+  struct EncodedFrame {
+    std::string category;
+    int index;
+  };
+
+  MockEncodingWriter(std::shared_ptr<MockWriterState> state) : m_state(std::move(state)) {
+  }
+
+  EncodedFrame encodeFrame(const podio::Frame& frame, const std::string& category,
+                           const std::vector<std::string>&) const {
+    const auto index = frame.getParameter<int>("index").value();
+    if (index == m_state->failAt) {
+      throw std::runtime_error("Failed to encode frame " + std::to_string(index));
+    }
+    m_state->nEncoded++;
+    return {category, index};
+  }
+
+  void writeEncodedFrame(EncodedFrame&& frame) {
+    m_state->write(frame.category, frame.index);
+  }
+
+  void finish() {
+    m_state->finished = true;
+  }
+
+  std::shared_ptr<MockWriterState> m_state;
+};
+
+podio::Frame makeFrame(int index) {
+  auto frame = podio::Frame();
+  frame.putParameter("index", index);
+  return frame;
+}
+
+/// Write nFrames events (with sequence numbers) and runs (without) from
+/// nThreads threads that each handle every nThreads-th frame
+void writeConcurrently(podio::ThreadSafeWriter& writer, int nThreads, int nFrames) {
+  std::vector<std::thread> threads;
+  for (int t = 0; t < nThreads; ++t) {
+    threads.emplace_back([&writer, t, nThreads, nFrames]() {
+      for (int i = t; i < nFrames; i += nThreads) {
+        writer.writeFrame(makeFrame(i), "events", i);
+        writer.writeFrame(makeFrame(i), "runs");
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+} // namespace
+
+TEST_CASE("ThreadSafeWriter keeps the sequence order", "[thread-safe-writer]") {
+  auto state = std::make_shared<MockWriterState>();
+  {
+    auto writer = podio::ThreadSafeWriter(std::make_unique<MockWriter>(state));
+    writeConcurrently(writer, 4, 50);
+  }
+
+  REQUIRE(state->finished);
+  REQUIRE_FALSE(state->overlapped);
+  REQUIRE(state->written.size() == 100);
+
+  std::vector<int> events;
+  std::vector<int> runs;
+  for (const auto& [category, index] : state->written) {
+    (category == "events" ? events : runs).push_back(index);
+  }
+  REQUIRE(events.size() == 50);
+  for (int i = 0; i < 50; ++i) {
+    REQUIRE(events[i] == i);
+  }
+  // Frames without a sequence number are all written, but in any order
+  std::ranges::sort(runs);
+  for (int i = 0; i < 50; ++i) {
+    REQUIRE(runs[i] == i);
+  }
+}
+
+TEST_CASE("ThreadSafeWriter with an encoding writer", "[thread-safe-writer]") {
+  auto state = std::make_shared<MockWriterState>();
+  auto writer = podio::ThreadSafeWriter(std::make_unique<MockEncodingWriter>(state));
+  writeConcurrently(writer, 4, 50);
+  writer.finish();
+
+  REQUIRE(state->finished);
+  REQUIRE_FALSE(state->overlapped);
+  REQUIRE(state->nEncoded == 100);
+  REQUIRE(state->written.size() == 100);
+  int nextEvent = 0;
+  for (const auto& [category, index] : state->written) {
+    if (category == "events") {
+      REQUIRE(index == nextEvent++);
+    }
+  }
+
+  REQUIRE_THROWS_AS(writer.writeFrame(makeFrame(50), "events"), std::runtime_error);
+}
+
+TEST_CASE("ThreadSafeWriter does not block the sequence on errors", "[thread-safe-writer]") {
+  auto state = std::make_shared<MockWriterState>();
+  state->failAt = 1;
+  auto writer = podio::ThreadSafeWriter(std::make_unique<MockEncodingWriter>(state));
+
+  // Start the later frames first, they have to wait for the failing one
+  auto later = std::thread([&writer]() {
+    writer.writeFrame(makeFrame(2), "events", 2);
+    writer.writeFrame(makeFrame(3), "events", 3);
+  });
+  writer.writeFrame(makeFrame(0), "events", 0);
+  REQUIRE_THROWS_AS(writer.writeFrame(makeFrame(1), "events", 1), std::runtime_error);
+  later.join();
+  writer.finish();
+
+  REQUIRE(state->written.size() == 3);
+  REQUIRE(state->written[0].second == 0);
+  REQUIRE(state->written[1].second == 2);
+  REQUIRE(state->written[2].second == 3);
+}
+
+TEST_CASE("ThreadSafeWriter does not block the sequence after finish", "[thread-safe-writer]") {
+  auto state = std::make_shared<MockWriterState>();
+  auto writer = podio::ThreadSafeWriter(std::make_unique<MockWriter>(state));
+
+  // The later frame waits for its turn, which only comes after finish
+  std::atomic<bool> laterThrew{false};
+  auto later = std::thread([&writer, &laterThrew]() {
+    try {
+      writer.writeFrame(makeFrame(1), "events", 1);
+    } catch (const std::runtime_error&) {
+      laterThrew = true;
+    }
+  });
+  writer.finish();
+  REQUIRE_THROWS_AS(writer.writeFrame(makeFrame(0), "events", 0), std::runtime_error);
+  later.join();
+
+  REQUIRE(laterThrew);
+  REQUIRE(state->written.empty());
+}
@@ -1,4 +1,5 @@
 // STL
+#include <atomic>
 #include <cstdint>
 #include <filesystem>
 #include <map>
@@ -6,6 +7,7 @@
 #include <stdexcept>
 #include <thread>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "catch2/catch_test_macros.hpp"
@@ -13,12 +15,18 @@
 #include "catch2/matchers/catch_matchers_vector.hpp"
 
 // podio specific includes
+#include "podio/CollectionBufferFactory.h"
 #include "podio/Frame.h"
 #include "podio/GenericParameters.h"
 #include "podio/ROOTLegacyReader.h"
 #include "podio/ROOTReader.h"
 #include "podio/ROOTWriter.h"
+#include "podio/WriterOptions.h"
 #include "podio/podioVersion.h"
+#include "podio/utilities/ThreadPool.h"
+
+#include "TBufferFile.h"
+#include "TClass.h"
 
 #ifndef PODIO_ENABLE_SIO
   #define PODIO_ENABLE_SIO 0
@@ -35,6 +43,7 @@
 #endif
 
 // Test data types
+#include "datamodel/DatamodelDefinition.h"
 #include "datamodel/EventInfoCollection.h"
 #include "datamodel/ExampleClusterCollection.h"
 #include "datamodel/ExampleForCyclicDependency1Collection.h"
@@ -226,6 +235,60 @@ TEST_CASE("Notebook", "[basics]") {
   REQUIRE(hits.energy().size() == hits.size());
 }
 
+TEST_CASE("Notebook columns", "[basics]") {
+  auto buffers = podio::CollectionBufferFactory::instance()
+                     .createBuffers("ExampleHitCollection", datamodel::meta::schemaVersion, false)
+                     .value();
+  for (unsigned i = 0; i < 12; ++i) {
+    buffers.dataAsVector<ExampleHitData>()->push_back({0xcaffeeULL, 0., 0., 0., double(i)});
+  }
+  auto readColl = buffers.createCollection(buffers, false);
+  readColl->prepareAfterRead();
+  const auto& hits = dynamic_cast<const ExampleHitCollection&>(*readColl);
+
+  // Collections that have been read hand out the columns of the read buffers
+  const auto energies = hits.energy_column();
+  REQUIRE(energies.size() == hits.size());
+  REQUIRE(energies.stride() == sizeof(ExampleHitData));
+  REQUIRE_FALSE(energies.isContiguous());
+  REQUIRE_THROWS_AS(energies.asSpan(), std::logic_error);
+  REQUIRE_THROWS_AS(energies.at(12), std::out_of_range);
+  int index = 0;
+  for (auto energy : energies) {
+    REQUIRE(double(index) == energy);
+    REQUIRE(energies[index] == energy);
+    ++index;
+  }
+
+  // The columns are views into the data, not copies
+  REQUIRE(&energies[3] == &hits.energy_column()[3]);
+  REQUIRE(hits.cellID_column()[3] == 0xcaffeeULL);
+
+  // The vectorized access gives the same values, before and after the
+  // elements have been accessed
+  REQUIRE(hits.energy(10) == std::vector<double>(energies.begin(), energies.begin() + 10));
+  REQUIRE(hits[11].energy() == 11.);
+  REQUIRE(hits.energy() == std::vector<double>(energies.begin(), energies.end()));
+
+  // Collections that have been created can still be changed via the handles,
+  // even after they have been prepared for writing
+  auto created = ExampleHitCollection();
+  created.create(0xcaffeeULL, 0., 0., 0., 1.);
+  created.prepareForWrite();
+  REQUIRE_THROWS_AS(created.energy_column(), std::logic_error);
+  created[0].energy(42.);
+  created.create();
+  REQUIRE(created.energy() == std::vector<double>{42., 0.});
+
+  // Subset collections never own the data
+  auto subset = ExampleHitCollection();
+  subset.setSubsetCollection();
+  subset.push_back(created[0]);
+  subset.prepareForWrite();
+  REQUIRE_THROWS_AS(subset.energy_column(), std::logic_error);
+  REQUIRE(subset.energy() == std::vector<double>{42.});
+}
+
 TEST_CASE("OneToOneRelations", "[basics][relations]") {
   bool success = true;
   auto cluster = MutableExampleCluster();
@@ -274,6 +337,44 @@ TEST_CASE("VariadicCreate", "[basics]") {
   REQUIRE(variadic_cluster.Clusters(0) == normal_cluster);
 }
 
+TEST_CASE("Contiguous storage", "[basics][memory-management]") {
+  // ExampleHit and ExampleCluster are generated with contiguousStorage. Make
+  // sure that handles stay valid while the collection grows its storage
+  auto hits = ExampleHitCollection();
+  auto clusters = ExampleClusterCollection();
+  std::vector<ExampleHit> hitHandles;
+  std::vector<ExampleCluster> clusterHandles;
+  for (int i = 0; i < 100; ++i) {
+    hitHandles.emplace_back(hits.create(0x42ULL, i, i, i, i));
+    auto cluster = clusters.create();
+    cluster.energy(i);
+    cluster.addHits(hitHandles.back());
+    clusterHandles.emplace_back(cluster);
+  }
+
+  // Objects created elsewhere can still be added
+  auto hit = MutableExampleHit();
+  hit.energy(100);
+  hits.push_back(hit);
+  hitHandles.emplace_back(hit);
+
+  REQUIRE(hits.size() == 101);
+  for (size_t i = 0; i < hits.size(); ++i) {
+    REQUIRE(hits[i] == hitHandles[i]);
+    REQUIRE(hitHandles[i].energy() == i);
+    REQUIRE(hitHandles[i].id().index == static_cast<int>(i));
+  }
+  for (size_t i = 0; i < clusters.size(); ++i) {
+    REQUIRE(clusters[i] == clusterHandles[i]);
+    REQUIRE(clusterHandles[i].Hits(0) == hitHandles[i]);
+  }
+
+  hits.clear();
+  REQUIRE(hits.empty());
+  auto newHit = hits.create();
+  REQUIRE(newHit.id().index == 0);
+}
+
 TEST_CASE("write_buffer", "[basics][io]") {
   auto coll = ExampleHitCollection();
   auto hit1 = coll.create(0x42ULL, 0., 0., 0., 0.);
@@ -345,6 +446,51 @@ TEST_CASE("thread-safe prepareForWrite", "[basics][multithread]") {
   }
 }
 
+TEST_CASE("ThreadPool", "[basics][multithread]") {
+  auto pool = podio::utils::ThreadPool(4);
+  REQUIRE(pool.size() == 4);
+
+  // Several threads use the same pool at the same time
+  constexpr size_t nTasks = 1000;
+  constexpr int nCallers = 3;
+  std::vector<std::vector<std::atomic<int>>> counts(nCallers);
+  std::vector<std::thread> callers{};
+  for (int c = 0; c < nCallers; ++c) {
+    counts[c] = std::vector<std::atomic<int>>(nTasks);
+    callers.emplace_back([&pool, &counts, c]() {
+      for (int rep = 0; rep < 10; ++rep) {
+        pool.parallelFor(nTasks, [&counts, c](size_t i) { counts[c][i]++; });
+      }
+    });
+  }
+  for (auto& t : callers) {
+    t.join();
+  }
+  for (const auto& callerCounts : counts) {
+    for (const auto& count : callerCounts) {
+      REQUIRE(count == 10);
+    }
+  }
+
+  // The first exception is rethrown and the pool can be used again afterwards
+  REQUIRE_THROWS_AS(pool.parallelFor(nTasks,
+                                     [](size_t i) {
+                                       if (i == 10) {
+                                         throw std::runtime_error("task failed");
+                                       }
+                                     }),
+                    std::runtime_error);
+  std::atomic<size_t> nRun{0};
+  pool.parallelFor(nTasks, [&nRun](size_t) { nRun++; });
+  REQUIRE(nRun == nTasks);
+
+  // The shared pools are only created once per number of threads
+  auto& sharedPool = podio::utils::sharedThreadPool(2);
+  REQUIRE(sharedPool.size() == 2);
+  REQUIRE(&podio::utils::sharedThreadPool(2) == &sharedPool);
+  REQUIRE(podio::utils::sharedThreadPool().size() == podio::utils::defaultNumThreads());
+}
+
 TEST_CASE("UserDataCollection print", "[basics]") {
   auto coll = podio::UserDataCollection<int32_t>();
   coll.push_back(1);
@@ -1004,6 +1150,90 @@ TEST_CASE("Preprocessor version tests", "[versioning]") {
   }
 }
 
+TEST_CASE("CollectionIDTable", "[basics][collection-id-table]") {
+  auto table = podio::CollectionIDTable();
+  const auto hitsID = table.add("hits");
+  const auto clustersID = table.add("clusters");
+  REQUIRE(table.add("hits") == hitsID);
+  REQUIRE(table.names().size() == 2);
+
+  REQUIRE(table.collectionID("clusters").value() == clustersID);
+  REQUIRE(table.name(hitsID).value() == "hits");
+  REQUIRE_FALSE(table.present("tracks"));
+  REQUIRE_FALSE(table.name(42).has_value());
+  REQUIRE_FALSE(table.isImmutable());
+
+  SECTION("Immutable tables") {
+    const auto immutable =
+        podio::CollectionIDTable::makeImmutable(std::vector(table.ids()), std::vector(table.names()));
+    REQUIRE(immutable->isImmutable());
+    REQUIRE(immutable->collectionID("hits").value() == hitsID);
+    REQUIRE(immutable->name(clustersID).value() == "clusters");
+    REQUIRE_FALSE(immutable->present("tracks"));
+
+    // Copies are mutable again and can be extended without affecting the original
+    auto copy = immutable->copy();
+    REQUIRE_FALSE(copy.isImmutable());
+    const auto tracksID = copy.add("tracks");
+    REQUIRE(copy.add("clusters") == clustersID);
+    REQUIRE(copy.name(tracksID).value() == "tracks");
+    REQUIRE(copy.collectionID("hits").value() == hitsID);
+    REQUIRE(copy.names().size() == 3);
+    REQUIRE_FALSE(immutable->present("tracks"));
+    REQUIRE(immutable->names().size() == 2);
+  }
+
+  SECTION("Tables constructed from existing mappings") {
+    const auto other = podio::CollectionIDTable({1, 2, 3}, {"a", "b", "c"});
+    REQUIRE(other.collectionID("b").value() == 2);
+    REQUIRE(other.name(3).value() == "c");
+    REQUIRE_FALSE(other.present(4));
+  }
+
+  SECTION("Tables streamed via ROOT I/O") {
+    // ROOT only streams the ids and the names and never calls any of the
+    // constructors that build the lookup index
+    auto* tableClass = TClass::GetClass<podio::CollectionIDTable>();
+    REQUIRE(tableClass);
+    TBufferFile buffer(TBuffer::kWrite);
+    buffer.WriteObjectAny(&table, tableClass);
+
+    buffer.SetReadMode();
+    buffer.SetBufferOffset(0);
+    auto readTable = std::unique_ptr<podio::CollectionIDTable>(
+        static_cast<podio::CollectionIDTable*>(buffer.ReadObjectAny(tableClass)));
+    REQUIRE(readTable);
+    REQUIRE(readTable->names() == table.names());
+    REQUIRE(readTable->collectionID("hits").value() == hitsID);
+    REQUIRE(readTable->name(clustersID).value() == "clusters");
+    REQUIRE(readTable->index("clusters").value() == 1);
+    REQUIRE_FALSE(readTable->present("tracks"));
+
+    REQUIRE(readTable->add("hits") == hitsID);
+    const auto tracksID = readTable->add("tracks");
+    REQUIRE(readTable->name(tracksID).value() == "tracks");
+    REQUIRE(readTable->names().size() == 3);
+  }
+}
+
+TEST_CASE("WriterOptions", "[basics][writer-options]") {
+  auto options = podio::WriterOptions{};
+  REQUIRE(options.getCompression("events").codec == podio::CompressionCodec::Default);
+  REQUIRE_FALSE(options.hasCategoryCompression("events"));
+
+  options.setCompression(podio::CompressionCodec::LZ4).setCompression("runs", podio::CompressionCodec::ZSTD, 9);
+  REQUIRE(options.getCompression("events").codec == podio::CompressionCodec::LZ4);
+  REQUIRE(options.getCompression("events").getLevel() == 4);
+  REQUIRE(options.hasCategoryCompression("runs"));
+  REQUIRE(options.getCompression("runs") == podio::CompressionSettings{podio::CompressionCodec::ZSTD, 9});
+
+  // No compression always uses level 0
+  options.setCompression("metadata", podio::CompressionCodec::None, 5);
+  REQUIRE(options.getCompression("metadata").getLevel() == 0);
+
+  REQUIRE_THROWS_AS(options.setCompression(podio::CompressionCodec::Zlib, 10), std::invalid_argument);
+}
+
 TEST_CASE("GenericParameters", "[generic-parameters]") {
   // Check that GenericParameters work as intended
   auto gp = podio::GenericParameters{};
@@ -1127,6 +1357,91 @@ TEST_CASE("GenericParameters constructors", "[generic-parameters]") {
   }
 }
 
+TEST_CASE("GenericParameters storage", "[generic-parameters]") {
+  auto gp = podio::GenericParameters{};
+  gp.set("c", 3);
+  gp.set("a", 1);
+  gp.set("b", {2, 2});
+  gp.set("a", 11);
+
+  // The keys are kept sorted and the values are stored at the same index
+  {
+    const auto view = gp.lockedView();
+    const auto& storage = view.getStorage<int>();
+    REQUIRE(storage.keys == std::vector<std::string>{"a", "b", "c"});
+    REQUIRE(storage.values == std::vector<std::vector<int>>{{11}, {2, 2}, {3}});
+    // Reading is still possible while the view holds the lock
+    REQUIRE(gp.getKeys<int>() == storage.keys);
+  }
+
+  // Already existing values are not overwritten by loadFrom
+  gp.loadFrom(std::vector<std::string>{"d", "a"}, std::vector<std::vector<int>>{{4}, {-1}});
+  REQUIRE(gp.getKeys<int>() == std::vector<std::string>{"a", "b", "c", "d"});
+  REQUIRE(gp.get<int>("a").value() == 11);
+  REQUIRE(gp.get<int>("d").value() == 4);
+
+  // The deprecated map access still works, but returns a copy
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+  const auto intMap = gp.getMap<int>();
+#pragma GCC diagnostic pop
+  REQUIRE(intMap.size() == 4);
+  REQUIRE(intMap.at("b") == std::vector{2, 2});
+  REQUIRE(intMap.at("d") == std::vector{4});
+
+  // Sorted keys are taken over as they are
+  auto other = podio::GenericParameters{};
+  other.loadFrom(std::vector<std::string>{"x", "y"}, std::vector<std::vector<float>>{{1.f}, {2.f, 3.f}});
+  REQUIRE(other.getN<float>("y") == 2);
+  REQUIRE_FALSE(other.get<float>("z"));
+
+  // A sorted storage is taken over without copying its contents
+  auto storage2 = podio::GenericParameters::Storage<double>{{"p", "q"}, {{1.0}, {2.0, 3.0}}};
+  const auto* keysData = storage2.keys.data();
+  const auto* valuesData = storage2.values[1].data();
+  other.loadFrom(std::move(storage2));
+  const auto view = other.lockedView();
+  const auto& doubleStorage = view.getStorage<double>();
+  REQUIRE(doubleStorage.keys.data() == keysData);
+  REQUIRE(doubleStorage.values[1].data() == valuesData);
+  REQUIRE(other.get<std::vector<double>>("q").value() == std::vector{2.0, 3.0});
+}
+
+TEST_CASE("GenericParameters snapshot", "[generic-parameters]") {
+  auto gp = podio::GenericParameters{};
+  gp.set("int", 42);
+  gp.set("strings", {"one", "two"});
+  REQUIRE_FALSE(gp.isReadOnly());
+
+  const auto snapshot = gp.snapshot();
+  REQUIRE(snapshot.isReadOnly());
+  REQUIRE(snapshot.get<int>("int").value() == 42);
+  REQUIRE(snapshot.get<std::vector<std::string>>("strings").value()[1] == "two");
+
+  // Changing the original does not affect the snapshot
+  gp.set("int", 43);
+  REQUIRE(snapshot.get<int>("int").value() == 42);
+
+  // Snapshots cannot be changed, but copies of them can
+  auto readOnly = gp.snapshot();
+  REQUIRE_THROWS_AS(readOnly.set("int", 44), std::logic_error);
+  REQUIRE_THROWS_AS(readOnly.clear(), std::logic_error);
+  auto copy = podio::GenericParameters(readOnly);
+  REQUIRE_FALSE(copy.isReadOnly());
+  copy.set("int", 44);
+  REQUIRE(copy.get<int>("int").value() == 44);
+  REQUIRE(readOnly.get<int>("int").value() == 43);
+
+  // Moved-from snapshots are empty and can be changed again
+  const auto moved = std::move(readOnly);
+  REQUIRE(moved.isReadOnly());
+  REQUIRE(moved.get<int>("int").value() == 43);
+  REQUIRE_FALSE(readOnly.isReadOnly()); // NOLINT(bugprone-use-after-move)
+  REQUIRE(readOnly.empty());
+  readOnly.set("int", 45);
+  REQUIRE(readOnly.get<int>("int").value() == 45);
+}
+
 TEST_CASE("Missing files (ROOT readers)", "[basics]") {
   auto root_legacy_reader = podio::ROOTLegacyReader();
   REQUIRE_THROWS_AS(root_legacy_reader.openFile("NonExistentFile.root"), std::runtime_error);
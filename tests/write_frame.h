@@ -30,10 +30,15 @@
 
 #include "podio/Frame.h"
 #include "podio/LinkCollection.h"
+#include "podio/ThreadSafeWriter.h"
 #include "podio/UserDataCollection.h"
+#include "podio/WriterOptions.h"
 
+#include <memory>
 #include <string>
+#include <thread>
 #include <tuple>
+#include <vector>
 
 auto createMCCollection() {
   auto mcps = ExampleMCCollection();
@@ -541,8 +546,8 @@ podio::Frame makeFrame(int iFrame) {
 }
 
 template <typename WriterT>
-void write_frames(const std::string& filename) {
-  WriterT writer(filename);
+void write_frames(const std::string& filename, const podio::WriterOptions& options = {}) {
+  WriterT writer(filename, options);
 
   for (int i = 0; i < 10; ++i) {
     auto frame = makeFrame(i);
@@ -557,4 +562,27 @@ void write_frames(const std::string& filename) {
   writer.finish();
 }
 
+/// Write the same Frames as write_frames, but from several threads that share
+/// one ThreadSafeWriter. The sequence numbers make sure that the Frames end up
+/// in the file in the same order
+template <typename WriterT>
+void write_frames_concurrent(const std::string& filename, int nThreads = 4) {
+  podio::ThreadSafeWriter writer(std::make_unique<WriterT>(filename));
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < nThreads; ++t) {
+    threads.emplace_back([&writer, t, nThreads]() {
+      for (int i = t; i < 10; i += nThreads) {
+        writer.writeFrame(makeFrame(i), podio::Category::Event, collsToWrite, i);
+        writer.writeFrame(makeFrame(100 + i), "other_events", i);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  writer.finish();
+}
+
 #endif // PODIO_TESTS_WRITE_FRAME_H